@@ -0,0 +1,135 @@
+// Copyright 2025 RestingImmortal
+
+#include "AllocationTracker.hpp"
+
+#ifdef HORIZONS_TRACK_ALLOCATIONS
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace {
+    struct alignas(64) ScopeCounters {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    // Plain globals rather than function statics, since operator new can run before main and must never allocate itself.
+    // The scope is constant initialised, so giving each thread its own doesn't allocate either.
+    thread_local uint32_t t_current_scope = 0;
+    std::array<ScopeCounters, AllocationTracker::k_max_scopes> g_counters;
+
+    void count(const std::size_t size) noexcept {
+        auto& counters = g_counters[t_current_scope];
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void* allocate(const std::size_t size) noexcept {
+        count(size);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* allocate_aligned(const std::size_t size, const std::align_val_t alignment) noexcept {
+        count(size);
+        const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // aligned_alloc wants the size to be a multiple of the alignment.
+        return std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+#endif
+    }
+
+    void deallocate_aligned(void* pointer) noexcept {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+// Public Methods
+
+uint32_t AllocationTracker::enter(const uint32_t scope) noexcept {
+    return std::exchange(t_current_scope, scope < k_max_scopes ? scope : 0);
+}
+
+AllocationTracker::Counts AllocationTracker::leave(const uint32_t previous_scope) noexcept {
+    // Workers may have counted towards this scope too, but they're all done by the time the thread that entered it leaves.
+    auto& counters = g_counters[std::exchange(t_current_scope, previous_scope)];
+    return {
+        counters.allocations.exchange(0, std::memory_order_relaxed),
+        counters.bytes.exchange(0, std::memory_order_relaxed)
+    };
+}
+
+uint32_t AllocationTracker::current() noexcept {
+    return t_current_scope;
+}
+
+// Global replacements. Every form has to be replaced, or memory could end up freed by a different allocator than made it.
+
+void* operator new(const std::size_t size) {
+    if (void* pointer = allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) {
+    if (void* pointer = allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+    if (void* pointer = allocate_aligned(size, alignment)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment) {
+    if (void* pointer = allocate_aligned(size, alignment)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_aligned(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_aligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept { deallocate_aligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { deallocate_aligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { deallocate_aligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { deallocate_aligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { deallocate_aligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { deallocate_aligned(pointer); }
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Counts heap allocations per scope, so per-frame allocations can be pinned on whichever system made them.
+// Only does anything in builds with HORIZONS_TRACK_ALLOCATIONS, which replace the global operator new and delete.
+// Otherwise everything here compiles away to nothing.
+//
+// Each thread has its own current scope, so a logging or loading thread doesn't get counted against whatever system the
+// main thread is in. ThreadPool workers take on the scope of whoever called run, so work a system hands to the pool still
+// counts as its own.
+class AllocationTracker {
+public:
+#ifdef HORIZONS_TRACK_ALLOCATIONS
+    static constexpr bool k_enabled = true;
+#else
+    static constexpr bool k_enabled = false;
+#endif
+
+    // Scope 0 catches everything that happens outside of a tracked scope, and anything past the last slot.
+    static constexpr uint32_t k_max_scopes = 64;
+
+    struct Counts {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+#ifdef HORIZONS_TRACK_ALLOCATIONS
+    // Starts sending allocations to scope. Returns the scope that was current, to be handed to leave.
+    static uint32_t enter(uint32_t scope) noexcept;
+
+    // Goes back to previous_scope, and returns and clears what was counted for the scope being left.
+    static Counts leave(uint32_t previous_scope) noexcept;
+
+    // The calling thread's scope.
+    [[nodiscard]]
+    static uint32_t current() noexcept;
+#else
+    static uint32_t enter(uint32_t) noexcept { return 0; }
+
+    static Counts leave(uint32_t) noexcept { return {}; }
+
+    [[nodiscard]]
+    static uint32_t current() noexcept { return 0; }
+#endif
+};
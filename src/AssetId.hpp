@@ -0,0 +1,29 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+
+// An asset the AssetManager has already found by name, reduced to an index into one of its tables.
+// Names only matter when reading data files. Past that, these are passed around instead, so nothing has to hash a string.
+// The tag keeps the different kinds of id from being mixed up.
+template <typename Tag>
+struct AssetId {
+    static constexpr uint32_t k_invalid = UINT32_MAX;
+
+    uint32_t index = k_invalid;
+
+    [[nodiscard]]
+    constexpr bool is_valid() const noexcept {
+        return index != k_invalid;
+    }
+
+    friend constexpr bool operator==(AssetId, AssetId) = default;
+    friend constexpr auto operator<=>(AssetId, AssetId) = default;
+};
+
+using TextureId = AssetId<struct TextureTag>;
+using ShipId    = AssetId<struct ShipTag>;
+using WeaponId  = AssetId<struct WeaponTag>;
+using FactionId = AssetId<struct FactionTag>;
@@ -2,18 +2,83 @@
 
 #include "AssetManager.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <iterator>
+#include <span>
+#include <system_error>
+#include <utility>
 
 #include "Logger.hpp"
 
+namespace {
+    template <typename Task>
+    void run_jobs(ThreadPool* thread_pool, const std::size_t count, Task&& task) {
+        if (thread_pool) {
+            thread_pool->run(count, task);
+            return;
+        }
+        for (std::size_t index = 0; index < count; index++) {
+            task(index);
+        }
+    }
+
+    // How many files each thread gets per batch in run_batched.
+    constexpr std::size_t k_batch_per_thread = 4;
+
+    // Runs load(index) across the pool a batch at a time, then store(index) on this thread for that batch in order,
+    // before moving on to the next. Only one batch of loaded files is ever waiting, so decoded textures never all sit
+    // in memory at once.
+    template <typename Load, typename Store>
+    void run_batched(ThreadPool* thread_pool, const std::size_t count, Load&& load, Store&& store) {
+        const std::size_t batch = (thread_pool ? thread_pool->get_thread_count() : 1) * k_batch_per_thread;
+
+        for (std::size_t first = 0; first < count; first += batch) {
+            const std::size_t size = std::min(batch, count - first);
+            run_jobs(thread_pool, size, [&](const std::size_t index) {
+                load(first + index);
+            });
+            for (std::size_t index = first; index < first + size; index++) {
+                store(index);
+            }
+        }
+    }
+
+    template <typename Data>
+    std::expected<Data, std::string> parse_asset(const std::filesystem::path& path) {
+        if (path.extension() == ".xml") {
+            pugi::xml_document doc;
+
+            if (
+                const pugi::xml_parse_result result = doc.load_file(path.c_str());
+                !result
+            ) {
+                return std::unexpected(std::string(result.description()));
+            }
+
+            return Data(doc);
+        }
+
+        try {
+            std::ifstream file(path);
+            return Data(json::parse(file));
+        } catch (const std::exception& e) {
+            return std::unexpected(std::string(e.what()));
+        }
+    }
+}
+
 WeaponData::WeaponData(const json& j) {
     munition = j.value("munition", "");
     damage   = j.value("damage", 0.0f);
     lifetime = j.value("lifetime", 0.0f);
     cooldown = j.value("cooldown", 0.0f);
     radius   = j.value("radius", 0.0f);
+    collision_layer = j.value("collision_layer", "Bullet");
 }
 
 WeaponData::WeaponData(const pugi::xml_document& d) {
@@ -23,6 +88,16 @@ WeaponData::WeaponData(const pugi::xml_document& d) {
     lifetime = root.child("lifetime").text().as_float(0.0f);
     cooldown = root.child("cooldown").text().as_float(0.0f);
     radius   = root.child("radius").text().as_float(0.0f);
+    collision_layer = root.child("collision_layer").text().as_string("Bullet");
+}
+
+WeaponData::WeaponData(const AssetPack& pack, const AssetPack::WeaponRecord& record) {
+    munition = pack.get_string(record.munition);
+    damage   = record.damage;
+    lifetime = record.lifetime;
+    cooldown = record.cooldown;
+    radius   = record.radius;
+    collision_layer = pack.get_string(record.collision_layer);
 }
 
 EngineData::EngineData(const json& j) {
@@ -38,10 +113,17 @@ EngineData::EngineData(const pugi::xml_document& d) {
     rotation = root.child("rotation").text().as_float(180.0f);
 }
 
+EngineData::EngineData(const AssetPack& pack, const AssetPack::EngineRecord& record) {
+    texture  = pack.get_string(record.texture);
+    thrust   = record.thrust;
+    rotation = record.rotation;
+}
+
 ShipData::ShipData(const json& j) {
     texture   = j.value("texture", "");
     max_speed = j.value("max_speed", 400.0f);
     radius    = j.value("radius", 0.0f);
+    collision_layer = j.value("collision_layer", "Ship");
     for (const auto& item : j["weapons"]) {
         weapons.push_back({
             .weapon_type = item.at("type").get<std::string>(),
@@ -62,6 +144,7 @@ ShipData::ShipData(const pugi::xml_document& d) {
     texture   = root.child("texture").text().as_string("");
     max_speed = root.child("max_speed").text().as_float(400.0f);
     radius    = root.child("radius").text().as_float(0.0f);
+    collision_layer = root.child("collision_layer").text().as_string("Ship");
     for (pugi::xml_node node : root.children("weapons")) {
         weapons.push_back({
             .weapon_type = node.child("type").text().as_string(),
@@ -78,6 +161,28 @@ ShipData::ShipData(const pugi::xml_document& d) {
     }
 }
 
+ShipData::ShipData(const AssetPack& pack, const AssetPack::ShipRecord& record) {
+    const auto& header = pack.get_header();
+    texture   = pack.get_string(record.texture);
+    max_speed = record.max_speed;
+    radius    = record.radius;
+    collision_layer = pack.get_string(record.collision_layer);
+    for (const auto& part : pack.get_slice<AssetPack::ShipPartRecord>(header.ship_parts, record.weapons)) {
+        weapons.push_back({
+            .weapon_type = std::string(pack.get_string(part.type)),
+            .x = part.x,
+            .y = part.y
+        });
+    }
+    for (const auto& part : pack.get_slice<AssetPack::ShipPartRecord>(header.ship_parts, record.engines)) {
+        engines.push_back({
+            .engine_type = std::string(pack.get_string(part.type)),
+            .x = part.x,
+            .y = part.y
+        });
+    }
+}
+
 MapData::MapData(const json& j) {
     metadata = { j.at("meta").at("name").get<std::string>() };
 
@@ -132,6 +237,33 @@ MapData::MapData(const pugi::xml_document& d) {
     }
 }
 
+MapData::MapData(const AssetPack& pack, const AssetPack::MapRecord& record) {
+    const auto& header = pack.get_header();
+    metadata = { std::string(pack.get_string(record.name)) };
+    for (const auto& background : pack.get_slice<AssetPack::BackgroundRecord>(header.map_backgrounds, record.backgrounds)) {
+        backgrounds.push_back({
+            .image = std::string(pack.get_string(background.image)),
+            .layer = background.layer
+        });
+    }
+    for (const auto& ship : pack.get_slice<AssetPack::MapShipRecord>(header.map_ships, record.ships)) {
+        ships.push_back({
+            .ship_type = std::string(pack.get_string(ship.ship_type)),
+            .x = ship.x,
+            .y = ship.y,
+            .affiliation = std::string(pack.get_string(ship.affiliation))
+        });
+    }
+    for (const auto& object : pack.get_slice<AssetPack::ObjectRecord>(header.map_objects, record.objects)) {
+        objects.push_back({
+            .texture = std::string(pack.get_string(object.texture)),
+            .x = object.x,
+            .y = object.y,
+            .layer = object.layer
+        });
+    }
+}
+
 StartData::StartData(const json &j) {
     name = j.at("name").get<std::string>();
     initial_map = j.at("initial map").get<std::string>();
@@ -153,6 +285,16 @@ StartData::StartData(const pugi::xml_document& d) {
     };
 }
 
+StartData::StartData(const AssetPack& pack, const AssetPack::StartRecord& record) {
+    name = pack.get_string(record.name);
+    initial_map = pack.get_string(record.initial_map);
+    player = {
+        .ship_type = std::string(pack.get_string(record.player_ship_type)),
+        .x = record.player_x,
+        .y = record.player_y
+    };
+}
+
 AffiliationData::AffiliationData(const json& j) {
     name = j.at("name").get<std::string>();
     for (auto relation : j["relations"]) {
@@ -174,189 +316,80 @@ AffiliationData::AffiliationData(const pugi::xml_document& d) {
     }
 }
 
-// Public Methods
-
-AssetManager::~AssetManager() {
-    unload_all();
+AffiliationData::AffiliationData(const AssetPack& pack, const AssetPack::AffiliationRecord& record) {
+    name = pack.get_string(record.name);
+    for (const auto& relation : pack.get_slice<AssetPack::RelationRecord>(pack.get_header().relations, record.relations)) {
+        relations.push_back({
+            .faction = std::string(pack.get_string(relation.faction)),
+            .relation = relation.relation
+        });
+    }
 }
 
-void AssetManager::load_assets() {
-    unload_all();
-
-    std::filesystem::path assets_dir = "./assets/";
-
-    if (!std::filesystem::exists(assets_dir)) {
-        H_CRITICAL("Asset Loading", "Assets directory not found!");
-        throw std::runtime_error("Assets directory not found!");
+CollisionData::CollisionData(const json& j) {
+    for (const auto& layer : j["layers"]) {
+        layers.push_back(layer.get<std::string>());
     }
+    for (const auto& item : j["interactions"]) {
+        interactions.push_back({
+            .first = item.at("first").get<std::string>(),
+            .second = item.at("second").get<std::string>()
+        });
+    }
+}
 
-    for (const auto& entry : std::filesystem::recursive_directory_iterator(assets_dir)) {
-        if (is_of_asset_type(entry, "start")) {
-            std::string start_name = get_asset_name_from_filename(entry);
-
-            if (is_xml(entry)) {
-                pugi::xml_document doc;
-
-                if (
-                    pugi::xml_parse_result result = doc.load_file(entry.path().c_str());
-                    !result
-                ) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), result.description());
-                    continue;
-                }
-
-                std::string key = doc.child("StartData").child("name").text().as_string();
-                m_start_assets.emplace(key, StartData(doc));
-                H_INFO("Asset Loader", "Loaded Start {}: {}", start_name, key);
-            } else if (is_json(entry)) {
-                try {
-                    std::ifstream file(entry.path());
-                    json jsonData = json::parse(file);
-                    auto key = jsonData.at("name").get<std::string>();
-                    m_start_assets.emplace(key, StartData(jsonData));
-                    H_INFO("Asset Loader", "Loaded Start {}: {}", start_name, key);
-                } catch (std::exception& e) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), e.what());
-                }
-            }
-        } else if (is_of_asset_type(entry, "map")) {
-            std::string map_name = get_asset_name_from_filename(entry);
-
-            if (is_xml(entry)) {
-                pugi::xml_document doc;
-
-                if (
-                    pugi::xml_parse_result result = doc.load_file(entry.path().c_str());
-                    !result
-                ) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), result.description());
-                    continue;
-                }
-
-                std::string key = doc.child("MapData").child("meta").child("name").text().as_string();
-                m_map_assets.emplace(key, MapData(doc));
-                H_INFO("Asset Loader", "Loaded Map {}: {}", map_name, key);
-            } else if (is_json(entry)) {
-                try {
-                    std::ifstream file(entry.path());
-                    json jsonData = json::parse(file);
-                    auto key = jsonData.at("meta").at("name").get<std::string>();
-                    m_map_assets.emplace(key, MapData(jsonData));
-                    H_INFO("Asset Loader", "Loaded Map {}: {}", map_name, key);
-                } catch (std::exception& e) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), e.what());
-                }
-            }
-        } else if (is_of_asset_type(entry, "engine")) {
-            std::string key = get_asset_name_from_filename(entry);
-
-            if (is_xml(entry)) {
-                pugi::xml_document doc;
-
-                if (
-                    pugi::xml_parse_result result = doc.load_file(entry.path().c_str());
-                    !result
-                ) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), result.description());
-                    continue;
-                }
+CollisionData::CollisionData(const pugi::xml_document& d) {
+    const auto root = d.child("CollisionData");
+    for (pugi::xml_node node : root.children("layers")) {
+        layers.emplace_back(node.text().as_string());
+    }
+    for (pugi::xml_node node : root.children("interactions")) {
+        interactions.push_back({
+            .first = node.child("first").text().as_string(),
+            .second = node.child("second").text().as_string()
+        });
+    }
+}
 
-                m_engine_assets.emplace(key, EngineData(doc));
-                H_INFO("Asset Loader", "Loaded Engine: {}", key);
-            } else if (is_json(entry)) {
-                try {
-                    std::ifstream file(entry.path());
-                    json jsonData = json::parse(file);
-                    m_engine_assets.emplace(key, EngineData(jsonData));
-                    H_INFO("Asset Loader", "Loaded Engine: {}", key);
-                } catch (const std::exception& e) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), e.what());
-                }
-            }
-        } else if (is_of_asset_type(entry, "weapon")) {
-            std::string key = get_asset_name_from_filename(entry);
-
-            if (is_xml(entry)) {
-                pugi::xml_document doc;
-
-                if (
-                    pugi::xml_parse_result result = doc.load_file(entry.path().c_str());
-                    !result
-                ) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), result.description());
-                    continue;
-                }
+CollisionData::CollisionData(const AssetPack& pack, const AssetPack::CollisionRecord& record) {
+    const auto& header = pack.get_header();
+    for (const auto& layer : pack.get_slice<AssetPack::String>(header.collision_layers, record.layers)) {
+        layers.emplace_back(pack.get_string(layer));
+    }
+    for (const auto& interaction : pack.get_slice<AssetPack::InteractionRecord>(header.collision_interactions, record.interactions)) {
+        interactions.push_back({
+            .first = std::string(pack.get_string(interaction.first)),
+            .second = std::string(pack.get_string(interaction.second))
+        });
+    }
+}
 
-                m_weapon_assets.emplace(key, WeaponData(doc));
-                H_INFO("Asset Loader", "Loaded Weapon: {}", key);
-            } else if (is_json(entry)) {
-                try {
-                    std::ifstream file(entry.path());
-                    json jsonData = json::parse(file);
-                    m_weapon_assets.emplace(key, WeaponData(jsonData));
-                    H_INFO("Asset Loader", "Loaded Weapon: {}", key);
-                } catch (const std::exception& e) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), e.what());
-                }
-            }
-        } else if (is_of_asset_type(entry, "ship")) {
-            std::string key = get_asset_name_from_filename(entry);
-
-            if (is_xml(entry)) {
-                pugi::xml_document doc;
-
-                if (
-                    pugi::xml_parse_result result = doc.load_file(entry.path().c_str());
-                    !result
-                ) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), result.description());
-                    continue;
-                }
+// Public Methods
 
-                m_ship_assets.emplace(key, ShipData(doc));
-                H_INFO("Asset Loader", "Loaded Ship: {}", key);
-            } else if (is_json(entry)) {
-                try {
-                    std::ifstream file(entry.path());
-                    json jsonData = json::parse(file);
-                    m_ship_assets.emplace(key, ShipData(jsonData));
-                    H_INFO("Asset Loader", "Loaded Ship: {}", key);
-                } catch (const std::exception& e) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), e.what());
-                }
-            }
-        } else if (is_of_asset_type(entry, "affiliation")) {
-            std::string key = get_asset_name_from_filename(entry);
-
-            if (is_xml(entry)) {
-                pugi::xml_document doc;
-
-                if (
-                    pugi::xml_parse_result result = doc.load_file(entry.path().c_str());
-                    !result
-                ) {
-                    H_ERROR("Asset Loader", "Error loading {}: {}", entry.path().string(), result.description());
-                    continue;
-                }
+AssetManager::~AssetManager() {
+    unload_all();
+}
 
-                m_raw_affiliations.emplace_back(doc);
-                H_INFO("Asset Loader", "Loaded Raw Affiliation: {}", key);
-            } else if (is_json(entry)) {
-                try {
-                    std::ifstream file(entry.path());
-                    json jsonData = json::parse(file);
-                    m_raw_affiliations.emplace_back(jsonData);
-                    H_INFO("Asset Loader", "Loaded Raw Affiliation: {}", key);
-                } catch (const std::exception& e) {
-                    H_ERROR("AssetLoader", "Error loading {}: {}", entry.path().string(), e.what());
-                }
-            }
-        } else if (is_texture_file(entry)) {
-            std::string name = get_texture_name(entry);
-            m_textures.emplace_back(entry.path().string());
-            m_texture_map[name] = m_textures.size() - 1;
-            H_INFO("Asset Loader", "Loaded Texture: {}", name);
+void AssetManager::load_assets(const bool load_textures, ThreadPool* thread_pool) {
+    unload_all();
+    m_textures_loaded = load_textures;
+
+    // A pack cooked from different files than are in ./assets/ now would quietly load stale assets.
+    // Without the directory at all, the pack is all there is.
+    const AssetPack pack(k_pack_path);
+    const bool pack_current = pack.is_open() && (
+        !std::filesystem::exists(k_assets_path) ||
+        pack.get_header().source_fingerprint == fingerprint_assets(k_assets_path)
+    );
+
+    if (pack_current) {
+        load_pack(pack, load_textures, thread_pool);
+    } else {
+        if (pack.is_open()) {
+            H_WARNING("Asset Loader", "{} is out of date with {}, so loading the loose files instead. Run horizons_cook to update it",
+                k_pack_path, k_assets_path);
         }
+        load_loose_files(load_textures, thread_pool);
     }
 
     // Post initial load processing
@@ -376,8 +409,9 @@ void AssetManager::load_assets() {
         H_INFO("Asset Loader", "Gave faction '{}' id {}", affiliation.name, id);
     }
 
-    // Create NxN relation table initialized to 0
-    m_relation_table.assign(faction_count, std::vector<int>(faction_count, 0));
+    // Create NxN relation table initialized to 0, stored row by row in one block
+    m_faction_count = faction_count;
+    m_relation_table.assign(faction_count * faction_count, 0);
 
     // Populate sparse relations
     for (std::size_t source_id = 0; source_id < faction_count; source_id++) {
@@ -396,9 +430,202 @@ void AssetManager::load_assets() {
             }
 
             std::size_t target_id = target_iter->second;
-            m_relation_table[source_id][target_id] = relation_entry.relation;
+            m_relation_table[source_id * faction_count + target_id] = relation_entry.relation;
         }
     }
+
+    compile_hostility();
+
+    compile_collision_layers();
+
+    compile_ship_prefabs();
+}
+
+void AssetManager::cook_pack(const std::filesystem::path& path, ThreadPool* thread_pool) {
+    unload_all();
+    m_textures_loaded = false;
+
+    // Taken first, so anything saved while cooking makes the pack look stale rather than current.
+    AssetPack::Contents contents;
+    contents.source_fingerprint = fingerprint_assets(k_assets_path);
+
+    load_loose_files(false, thread_pool);
+
+    // Sorted by name, so cooking the same assets twice gives the same pack.
+    const auto sorted_keys = [](const auto& assets) {
+        std::vector<const std::string*> keys;
+        keys.reserve(assets.size());
+        for (const auto& [key, value] : assets) {
+            keys.push_back(&key);
+        }
+        std::ranges::sort(keys, {}, [](const std::string* key) -> const std::string& { return *key; });
+        return keys;
+    };
+
+    for (const std::string* key : sorted_keys(m_weapon_assets)) {
+        const auto& weapon = m_weapon_assets.at(*key);
+        contents.weapons.push_back({
+            .name = contents.add_string(*key),
+            .munition = contents.add_string(weapon.munition),
+            .collision_layer = contents.add_string(weapon.collision_layer),
+            .damage = weapon.damage,
+            .lifetime = weapon.lifetime,
+            .cooldown = weapon.cooldown,
+            .radius = weapon.radius
+        });
+    }
+
+    for (const std::string* key : sorted_keys(m_engine_assets)) {
+        const auto& engine = m_engine_assets.at(*key);
+        contents.engines.push_back({
+            .name = contents.add_string(*key),
+            .texture = contents.add_string(engine.texture),
+            .thrust = engine.thrust,
+            .rotation = engine.rotation
+        });
+    }
+
+    std::vector<AssetPack::ShipPartRecord> parts;
+    for (const std::string* key : sorted_keys(m_ship_assets)) {
+        const auto& ship = m_ship_assets.at(*key);
+
+        parts.clear();
+        for (const auto& weapon : ship.weapons) {
+            parts.push_back({.type = contents.add_string(weapon.weapon_type), .x = weapon.x, .y = weapon.y});
+        }
+        const auto weapons = AssetPack::Contents::add_slice(contents.ship_parts, parts);
+
+        parts.clear();
+        for (const auto& engine : ship.engines) {
+            parts.push_back({.type = contents.add_string(engine.engine_type), .x = engine.x, .y = engine.y});
+        }
+        const auto engines = AssetPack::Contents::add_slice(contents.ship_parts, parts);
+
+        contents.ships.push_back({
+            .name = contents.add_string(*key),
+            .texture = contents.add_string(ship.texture),
+            .collision_layer = contents.add_string(ship.collision_layer),
+            .max_speed = ship.max_speed,
+            .radius = ship.radius,
+            .weapons = weapons,
+            .engines = engines
+        });
+    }
+
+    for (const std::string* key : sorted_keys(m_map_assets)) {
+        const auto& map = m_map_assets.at(*key);
+
+        std::vector<AssetPack::BackgroundRecord> backgrounds;
+        for (const auto& background : map.backgrounds) {
+            backgrounds.push_back({.image = contents.add_string(background.image), .layer = background.layer});
+        }
+
+        std::vector<AssetPack::MapShipRecord> ships;
+        for (const auto& ship : map.ships) {
+            ships.push_back({
+                .ship_type = contents.add_string(ship.ship_type),
+                .affiliation = contents.add_string(ship.affiliation),
+                .x = ship.x,
+                .y = ship.y
+            });
+        }
+
+        std::vector<AssetPack::ObjectRecord> objects;
+        for (const auto& object : map.objects) {
+            objects.push_back({
+                .texture = contents.add_string(object.texture),
+                .x = object.x,
+                .y = object.y,
+                .layer = object.layer
+            });
+        }
+
+        contents.maps.push_back({
+            .name = contents.add_string(*key),
+            .backgrounds = AssetPack::Contents::add_slice(contents.map_backgrounds, backgrounds),
+            .ships = AssetPack::Contents::add_slice(contents.map_ships, ships),
+            .objects = AssetPack::Contents::add_slice(contents.map_objects, objects)
+        });
+    }
+
+    for (const std::string* key : sorted_keys(m_start_assets)) {
+        const auto& start = m_start_assets.at(*key);
+        contents.starts.push_back({
+            .name = contents.add_string(*key),
+            .initial_map = contents.add_string(start.initial_map),
+            .player_ship_type = contents.add_string(start.player.ship_type),
+            .player_x = start.player.x,
+            .player_y = start.player.y
+        });
+    }
+
+    // Affiliations and collision data keep their order, as that's what ids are handed out by.
+    for (const auto& affiliation : m_raw_affiliations) {
+        std::vector<AssetPack::RelationRecord> relations;
+        for (const auto& relation : affiliation.relations) {
+            relations.push_back({.faction = contents.add_string(relation.faction), .relation = relation.relation});
+        }
+
+        contents.affiliations.push_back({
+            .name = contents.add_string(affiliation.name),
+            .relations = AssetPack::Contents::add_slice(contents.relations, relations)
+        });
+    }
+
+    for (const auto& collision : m_raw_collision_data) {
+        std::vector<AssetPack::String> layers;
+        for (const auto& layer : collision.layers) {
+            layers.push_back(contents.add_string(layer));
+        }
+
+        std::vector<AssetPack::InteractionRecord> interactions;
+        for (const auto& interaction : collision.interactions) {
+            interactions.push_back({
+                .first = contents.add_string(interaction.first),
+                .second = contents.add_string(interaction.second)
+            });
+        }
+
+        contents.collisions.push_back({
+            .layers = AssetPack::Contents::add_slice(contents.collision_layers, layers),
+            .interactions = AssetPack::Contents::add_slice(contents.collision_interactions, interactions)
+        });
+    }
+
+    // Textures go in as their files. Decoding them is left for load time, since a decoded image is far bigger.
+    std::vector<AssetFile> textures = scan_assets(k_assets_path, true, thread_pool);
+    std::erase_if(textures, [](const AssetFile& file) { return file.kind != AssetKind::Texture; });
+
+    std::vector<std::vector<std::byte>> texture_bytes(textures.size());
+    run_jobs(thread_pool, textures.size(), [&](const std::size_t index) {
+        std::ifstream file(textures[index].path, std::ios::binary);
+        const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        texture_bytes[index].resize(bytes.size());
+        std::memcpy(texture_bytes[index].data(), bytes.data(), bytes.size());
+    });
+
+    for (std::size_t index = 0; index < textures.size(); index++) {
+        if (texture_bytes[index].empty()) {
+            throw std::runtime_error(std::format("Couldn't read {}", textures[index].path.string()));
+        }
+
+        contents.textures.push_back({
+            .name = contents.add_string(textures[index].name),
+            .offset = contents.blobs.size(),
+            .size = texture_bytes[index].size()
+        });
+        contents.blobs.insert(contents.blobs.end(), texture_bytes[index].begin(), texture_bytes[index].end());
+    }
+
+    if (!AssetPack::write(path, contents)) {
+        throw std::runtime_error(std::format("Couldn't write {}", path.string()));
+    }
+
+    H_INFO(
+        "Asset Cooker", "Cooked {} ships, {} weapons, {} engines, {} maps, {} starts, and {} textures into {}",
+        contents.ships.size(), contents.weapons.size(), contents.engines.size(), contents.maps.size(),
+        contents.starts.size(), contents.textures.size(), path.string()
+    );
 }
 
 [[nodiscard]]
@@ -409,6 +636,19 @@ std::expected<const ShipData*, std::string> AssetManager::get_ship(const std::st
     return std::unexpected("Ship '" + name + "' not found");
 }
 
+[[nodiscard]]
+std::expected<ShipId, std::string> AssetManager::get_ship_id(const std::string& name) const {
+    if (const auto it = m_ship_ids.find(name); it != m_ship_ids.end()) {
+        return it->second;
+    }
+    return std::unexpected("Ship '" + name + "' not found");
+}
+
+[[nodiscard]]
+const ShipPrefab& AssetManager::get_ship_prefab(const ShipId id) const {
+    return m_ship_prefabs[id.index];
+}
+
 [[nodiscard]]
 std::expected<const WeaponData*, std::string> AssetManager::get_weapon(const std::string& name) const {
     if (const auto it = m_weapon_assets.find(name); it != m_weapon_assets.end()) {
@@ -417,6 +657,19 @@ std::expected<const WeaponData*, std::string> AssetManager::get_weapon(const std
     return std::unexpected("Weapon '" + name + "' not found");
 }
 
+[[nodiscard]]
+std::expected<WeaponId, std::string> AssetManager::get_weapon_id(const std::string& name) const {
+    if (const auto it = m_weapon_ids.find(name); it != m_weapon_ids.end()) {
+        return it->second;
+    }
+    return std::unexpected("Weapon '" + name + "' not found");
+}
+
+[[nodiscard]]
+const WeaponData& AssetManager::get_weapon(const WeaponId id) const {
+    return *m_weapons[id.index];
+}
+
 [[nodiscard]]
 std::expected<const EngineData*, std::string> AssetManager::get_engine(const std::string& name) const {
     if (const auto it = m_engine_assets.find(name); it != m_engine_assets.end()) {
@@ -443,39 +696,71 @@ std::expected<const StartData *, std::string> AssetManager::get_start(const std:
 
 [[nodiscard]]
 raylib::TextureUnmanaged& AssetManager::get_texture(const std::string& name) {
-    if (const auto it = m_texture_map.find(name); it != m_texture_map.end()) {
-        return m_textures[it->second];
+    return get_texture(get_texture_id(name));
+}
+
+[[nodiscard]]
+raylib::TextureUnmanaged& AssetManager::get_texture(const TextureId id) {
+    if (id.index < m_textures.size()) {
+        return m_textures[id.index];
+    }
+    if (!m_textures_loaded) {
+        static raylib::TextureUnmanaged empty_texture;
+        return empty_texture;
     }
-    H_ERROR("Asset Loader", "Could not find texture: {}", name);
     return get_error_texture();
 }
 
 [[nodiscard]]
-std::expected<const uint32_t, std::string>AssetManager::get_faction_id(const std::string& name) const {
+TextureId AssetManager::get_texture_id(const std::string& name) const {
+    if (const auto it = m_texture_map.find(name); it != m_texture_map.end()) {
+        return TextureId{static_cast<uint32_t>(it->second)};
+    }
+    if (m_textures_loaded) {
+        H_ERROR("Asset Loader", "Could not find texture: {}", name);
+    }
+    return TextureId{};
+}
+
+[[nodiscard]]
+std::expected<FactionId, std::string> AssetManager::get_faction_id(const std::string& name) const {
     if (const auto it = m_faction_name_to_id.find(name); it != m_faction_name_to_id.end()) {
-        return it->second;
+        return FactionId{static_cast<uint32_t>(it->second)};
     }
     return std::unexpected("Affiliation '" + name +"' not assigned an id");
 }
 
 [[nodiscard]]
-std::expected<const int, std::string> AssetManager::get_relation(const uint32_t base_faction, const uint32_t sub_faction) const {
-    if (base_faction >= m_relation_table.size()) {
+std::expected<const int, std::string> AssetManager::get_relation(const FactionId base_faction, const FactionId sub_faction) const {
+    if (base_faction.index >= m_faction_count) {
         return std::unexpected(
-            std::format("Base Faction Index {} is out of bounds ({})", base_faction, m_relation_table.size())
+            std::format("Base Faction Index {} is out of bounds ({})", base_faction.index, m_faction_count)
         );
     }
 
-    if (
-        const auto& sub = m_relation_table[base_faction];
-        sub_faction >= sub.size()
-    ) {
+    if (sub_faction.index >= m_faction_count) {
         return std::unexpected(
-            std::format("Sub Faction Index {} is out of bounds for Base {} ({})", sub_faction, base_faction, sub.size())
+            std::format("Sub Faction Index {} is out of bounds for Base {} ({})", sub_faction.index, base_faction.index, m_faction_count)
         );
     }
 
-    return m_relation_table[base_faction][sub_faction];
+    return m_relation_table[base_faction.index * m_faction_count + sub_faction.index];
+}
+
+[[nodiscard]]
+std::expected<const uint32_t, std::string> AssetManager::get_collision_layer(const std::string& name) const {
+    // At most 32 layers, so a linear scan beats hashing the name.
+    for (std::size_t layer = 0; layer < m_collision_layers.names.size(); layer++) {
+        if (m_collision_layers.names[layer] == name) {
+            return static_cast<uint32_t>(layer);
+        }
+    }
+    return std::unexpected("Collision layer '" + name + "' not declared");
+}
+
+[[nodiscard]]
+const CollisionLayers& AssetManager::get_collision_layers() const {
+    return m_collision_layers;
 }
 
 // Private methods
@@ -510,6 +795,419 @@ std::string AssetManager::get_texture_name(const std::filesystem::directory_entr
     return entry.path().stem().string();
 }
 
+std::optional<AssetManager::AssetFile> AssetManager::get_asset_file(
+    const std::filesystem::directory_entry& entry, const bool load_textures
+) {
+    static const std::array<std::pair<AssetKind, std::string>, 7> asset_types = {{
+        {AssetKind::Start, "start"},
+        {AssetKind::Map, "map"},
+        {AssetKind::Engine, "engine"},
+        {AssetKind::Weapon, "weapon"},
+        {AssetKind::Ship, "ship"},
+        {AssetKind::Affiliation, "affiliation"},
+        {AssetKind::Collision, "collision"}
+    }};
+
+    for (const auto& [kind, type] : asset_types) {
+        if (is_of_asset_type(entry, type)) {
+            return AssetFile{entry.path(), kind, get_asset_name_from_filename(entry)};
+        }
+    }
+
+    if (load_textures && is_texture_file(entry)) {
+        return AssetFile{entry.path(), AssetKind::Texture, get_texture_name(entry)};
+    }
+
+    return std::nullopt;
+}
+
+std::vector<AssetManager::AssetFile> AssetManager::scan_assets(
+    const std::filesystem::path& directory, const bool load_textures, ThreadPool* thread_pool
+) {
+    std::vector<AssetFile> files;
+    std::vector<std::filesystem::directory_entry> folders;
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.is_directory()) {
+            folders.push_back(entry);
+        } else if (auto file = get_asset_file(entry, load_textures)) {
+            files.push_back(std::move(*file));
+        }
+    }
+
+    std::vector<std::vector<AssetFile>> found(folders.size());
+    run_jobs(thread_pool, folders.size(), [&](const std::size_t index) {
+        // Thrown on a worker, this would take the whole game down, so what could be found is kept instead.
+        try {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(folders[index])) {
+                if (auto file = get_asset_file(entry, load_textures)) {
+                    found[index].push_back(std::move(*file));
+                }
+            }
+        } catch (const std::filesystem::filesystem_error& e) {
+            H_ERROR("Asset Loader", "Error scanning {}: {}", folders[index].path().string(), e.what());
+        }
+    });
+
+    for (auto& folder : found) {
+        files.insert(files.end(), std::make_move_iterator(folder.begin()), std::make_move_iterator(folder.end()));
+    }
+
+    std::ranges::sort(files, {}, &AssetFile::path);
+    return files;
+}
+
+uint64_t AssetManager::fingerprint_assets(const std::filesystem::path& directory) {
+    struct Entry {
+        std::string path;
+        uint64_t size;
+        int64_t modified;
+    };
+
+    // Directory order isn't stable, so the entries are sorted before being hashed.
+    std::vector<Entry> entries;
+    std::error_code error;
+    for (
+        auto it = std::filesystem::recursive_directory_iterator(directory, error);
+        !error && it != std::filesystem::recursive_directory_iterator();
+        it.increment(error)
+    ) {
+        if (!it->is_regular_file(error)) {
+            continue;
+        }
+        entries.push_back({
+            .path = std::filesystem::relative(it->path(), directory, error).generic_string(),
+            .size = it->file_size(error),
+            .modified = static_cast<int64_t>(it->last_write_time(error).time_since_epoch().count())
+        });
+    }
+    std::ranges::sort(entries, {}, &Entry::path);
+
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](const void* data, const std::size_t size) {
+        for (const auto byte : std::span(static_cast<const unsigned char*>(data), size)) {
+            hash = (hash ^ byte) * 1099511628211ull;
+        }
+    };
+    for (const auto& entry : entries) {
+        mix(entry.path.data(), entry.path.size() + 1);
+        mix(&entry.size, sizeof(entry.size));
+        mix(&entry.modified, sizeof(entry.modified));
+    }
+    return hash;
+}
+
+AssetManager::LoadedAsset AssetManager::load_asset(const AssetFile& file) {
+    const auto to_loaded = [](auto parsed) -> LoadedAsset {
+        if (!parsed) {
+            return {.data = {}, .error = std::move(parsed.error())};
+        }
+        return {.data = std::move(*parsed), .error = {}};
+    };
+
+    switch (file.kind) {
+        case AssetKind::Start:       return to_loaded(parse_asset<StartData>(file.path));
+        case AssetKind::Map:         return to_loaded(parse_asset<MapData>(file.path));
+        case AssetKind::Engine:      return to_loaded(parse_asset<EngineData>(file.path));
+        case AssetKind::Weapon:      return to_loaded(parse_asset<WeaponData>(file.path));
+        case AssetKind::Ship:        return to_loaded(parse_asset<ShipData>(file.path));
+        case AssetKind::Affiliation: return to_loaded(parse_asset<AffiliationData>(file.path));
+        case AssetKind::Collision:   return to_loaded(parse_asset<CollisionData>(file.path));
+        case AssetKind::Texture: {
+            const Image image = LoadImage(file.path.string().c_str());
+            if (!IsImageValid(image)) {
+                return {.data = {}, .error = "Couldn't decode image"};
+            }
+            return {.data = image, .error = {}};
+        }
+    }
+
+    return {};
+}
+
+void AssetManager::store_asset(const AssetFile& file, LoadedAsset& asset) {
+    if (!asset.error.empty()) {
+        H_ERROR("Asset Loader", "Error loading {}: {}", file.path.string(), asset.error);
+        return;
+    }
+
+    switch (file.kind) {
+        case AssetKind::Start: {
+            auto& start = std::get<StartData>(asset.data);
+            std::string key = start.name;
+            H_INFO("Asset Loader", "Loaded Start {}: {}", file.name, key);
+            m_start_assets.emplace(std::move(key), std::move(start));
+            break;
+        }
+        case AssetKind::Map: {
+            auto& map = std::get<MapData>(asset.data);
+            std::string key = map.metadata.name;
+            H_INFO("Asset Loader", "Loaded Map {}: {}", file.name, key);
+            m_map_assets.emplace(std::move(key), std::move(map));
+            break;
+        }
+        case AssetKind::Engine:
+            m_engine_assets.emplace(file.name, std::move(std::get<EngineData>(asset.data)));
+            H_INFO("Asset Loader", "Loaded Engine: {}", file.name);
+            break;
+        case AssetKind::Weapon:
+            m_weapon_assets.emplace(file.name, std::move(std::get<WeaponData>(asset.data)));
+            H_INFO("Asset Loader", "Loaded Weapon: {}", file.name);
+            break;
+        case AssetKind::Ship:
+            m_ship_assets.emplace(file.name, std::move(std::get<ShipData>(asset.data)));
+            H_INFO("Asset Loader", "Loaded Ship: {}", file.name);
+            break;
+        case AssetKind::Affiliation:
+            m_raw_affiliations.push_back(std::move(std::get<AffiliationData>(asset.data)));
+            H_INFO("Asset Loader", "Loaded Raw Affiliation: {}", file.name);
+            break;
+        case AssetKind::Collision:
+            m_raw_collision_data.push_back(std::move(std::get<CollisionData>(asset.data)));
+            H_INFO("Asset Loader", "Loaded Collision Layers: {}", file.name);
+            break;
+        case AssetKind::Texture: {
+            const Image image = std::get<Image>(asset.data);
+            m_textures.emplace_back(LoadTextureFromImage(image));
+            UnloadImage(image);
+            m_texture_map[file.name] = m_textures.size() - 1;
+            H_INFO("Asset Loader", "Loaded Texture: {}", file.name);
+            break;
+        }
+    }
+}
+
+void AssetManager::load_loose_files(const bool load_textures, ThreadPool* thread_pool) {
+    const std::filesystem::path assets_dir = k_assets_path;
+
+    if (!std::filesystem::exists(assets_dir)) {
+        H_CRITICAL("Asset Loading", "Assets directory not found!");
+        throw std::runtime_error("Assets directory not found!");
+    }
+
+    // Reading and parsing happen across the pool, and only what touches the GPU or this object happens back here.
+    // Files are stored in path order, so ids come out the same however the work was split up.
+    const std::vector<AssetFile> files = scan_assets(assets_dir, load_textures, thread_pool);
+
+    std::vector<LoadedAsset> loaded(files.size());
+    run_batched(thread_pool, files.size(),
+        [&](const std::size_t index) {
+            loaded[index] = load_asset(files[index]);
+        },
+        [&](const std::size_t index) {
+            store_asset(files[index], loaded[index]);
+        }
+    );
+}
+
+void AssetManager::load_pack(const AssetPack& pack, const bool load_textures, ThreadPool* thread_pool) {
+    const auto& header = pack.get_header();
+
+    for (const auto& record : pack.get_table<AssetPack::WeaponRecord>(header.weapons)) {
+        m_weapon_assets.emplace(pack.get_string(record.name), WeaponData(pack, record));
+    }
+    for (const auto& record : pack.get_table<AssetPack::EngineRecord>(header.engines)) {
+        m_engine_assets.emplace(pack.get_string(record.name), EngineData(pack, record));
+    }
+    for (const auto& record : pack.get_table<AssetPack::ShipRecord>(header.ships)) {
+        m_ship_assets.emplace(pack.get_string(record.name), ShipData(pack, record));
+    }
+    for (const auto& record : pack.get_table<AssetPack::MapRecord>(header.maps)) {
+        m_map_assets.emplace(pack.get_string(record.name), MapData(pack, record));
+    }
+    for (const auto& record : pack.get_table<AssetPack::StartRecord>(header.starts)) {
+        m_start_assets.emplace(pack.get_string(record.name), StartData(pack, record));
+    }
+    for (const auto& record : pack.get_table<AssetPack::AffiliationRecord>(header.affiliations)) {
+        m_raw_affiliations.emplace_back(pack, record);
+    }
+    for (const auto& record : pack.get_table<AssetPack::CollisionRecord>(header.collisions)) {
+        m_raw_collision_data.emplace_back(pack, record);
+    }
+
+    if (load_textures) {
+        // Decoded straight out of the pack, then uploaded in order like loose textures are.
+        const auto textures = pack.get_table<AssetPack::TextureRecord>(header.textures);
+        std::vector<Image> images(textures.size());
+        run_batched(thread_pool, textures.size(),
+            [&](const std::size_t index) {
+                const auto bytes = pack.get_texture_bytes(textures[index]);
+                images[index] = LoadImageFromMemory(
+                    ".png", reinterpret_cast<const unsigned char*>(bytes.data()), static_cast<int>(bytes.size())
+                );
+            },
+            [&](const std::size_t index) {
+                const std::string name(pack.get_string(textures[index].name));
+                if (!IsImageValid(images[index])) {
+                    H_ERROR("Asset Loader", "Error loading texture {} from {}: Couldn't decode image", name, k_pack_path);
+                    return;
+                }
+
+                m_textures.emplace_back(LoadTextureFromImage(images[index]));
+                UnloadImage(images[index]);
+                m_texture_map[name] = m_textures.size() - 1;
+            }
+        );
+    }
+
+    H_INFO(
+        "Asset Loader", "Loaded {} ships, {} weapons, {} engines, {} maps, {} starts, and {} textures from {}",
+        m_ship_assets.size(), m_weapon_assets.size(), m_engine_assets.size(), m_map_assets.size(),
+        m_start_assets.size(), m_textures.size(), k_pack_path
+    );
+}
+
+void AssetManager::compile_hostility() {
+    // One extra row and column of zeroes, which is where out of range ids get clamped to.
+    m_hostility_words = (m_faction_count + 1 + 63) / 64;
+    m_hostility.assign((m_faction_count + 1) * m_hostility_words, 0);
+
+    // Hostility is mutual: if either side dislikes the other, they fight.
+    for (std::size_t a = 0; a < m_faction_count; a++) {
+        for (std::size_t b = 0; b < m_faction_count; b++) {
+            if (
+                m_relation_table[a * m_faction_count + b] < 0 ||
+                m_relation_table[b * m_faction_count + a] < 0
+            ) {
+                m_hostility[a * m_hostility_words + b / 64] |= uint64_t{1} << (b % 64);
+            }
+        }
+    }
+}
+
+void AssetManager::compile_collision_layers() {
+    m_collision_layers = {};
+
+    // Without any declared layers, fall back to ships and bullets hitting each other and nothing else.
+    if (m_raw_collision_data.empty()) {
+        m_collision_layers.names = {"Ship", "Bullet"};
+        m_collision_layers.masks[0] = 0b10u;
+        m_collision_layers.masks[1] = 0b1u;
+        return;
+    }
+
+    for (const auto& data : m_raw_collision_data) {
+        for (const auto& layer : data.layers) {
+            if (std::ranges::find(m_collision_layers.names, layer) != m_collision_layers.names.end()) {
+                continue;
+            }
+
+            if (m_collision_layers.names.size() >= CollisionLayers::k_max_layers) {
+                throw std::runtime_error(std::format(
+                    "Collision layer '{}' exceeds the limit of {} layers",
+                    layer, CollisionLayers::k_max_layers
+                ));
+            }
+
+            m_collision_layers.names.push_back(layer);
+            H_INFO("Asset Loader", "Gave collision layer '{}' id {}", layer, m_collision_layers.names.size() - 1);
+        }
+    }
+
+    for (const auto& data : m_raw_collision_data) {
+        for (const auto& interaction : data.interactions) {
+            const auto first = get_collision_layer(interaction.first);
+            const auto second = get_collision_layer(interaction.second);
+
+            if (!first || !second) {
+                throw std::runtime_error(std::format(
+                    "Collision interaction between '{}' and '{}' uses an undeclared layer",
+                    interaction.first, interaction.second
+                ));
+            }
+
+            // Interactions go both ways.
+            m_collision_layers.masks[*first]  |= 1u << *second;
+            m_collision_layers.masks[*second] |= 1u << *first;
+        }
+    }
+}
+
+void AssetManager::compile_ship_prefabs() {
+    m_weapons.clear();
+    m_weapon_ids.clear();
+    m_weapons.reserve(m_weapon_assets.size());
+    m_weapon_ids.reserve(m_weapon_assets.size());
+    for (const auto& [key, weapon] : m_weapon_assets) {
+        m_weapon_ids.emplace(key, WeaponId{static_cast<uint32_t>(m_weapons.size())});
+        m_weapons.push_back(&weapon);
+    }
+
+    m_ship_prefabs.clear();
+    m_ship_ids.clear();
+    m_ship_prefabs.reserve(m_ship_assets.size());
+    m_ship_ids.reserve(m_ship_assets.size());
+
+    for (const auto& [key, ship] : m_ship_assets) {
+        ShipPrefab prefab = {
+            .texture = get_texture(ship.texture),
+            .max_speed = ship.max_speed,
+            .radius = ship.radius,
+            .collision_layer = CollisionLayers::k_no_layer,
+            .thrust = 0.0f,
+            .rotation = 0.0f,
+        };
+
+        if (
+            const auto layer = get_collision_layer(ship.collision_layer);
+            !layer
+        ) {
+            H_WARNING("Asset Loader", "Ship '{}' won't collide: {}", key, layer.error());
+        } else {
+            prefab.collision_layer = *layer;
+        }
+
+        // Anything missing is left out of the prefab entirely, rather than spawning as an empty child every time.
+        prefab.weapons.reserve(ship.weapons.size());
+        for (const auto& weapon : ship.weapons) {
+            const auto weapon_result = get_weapon_id(weapon.weapon_type);
+            if (!weapon_result) {
+                H_WARNING("Asset Loader", "Ship '{}' will be missing a weapon: {}", key, weapon_result.error());
+                continue;
+            }
+
+            const auto& data = get_weapon(*weapon_result);
+            const auto layer = get_collision_layer(data.collision_layer);
+            if (!layer) {
+                H_WARNING("Asset Loader", "Weapon '{}' will fire bullets that can't collide: {}", weapon.weapon_type, layer.error());
+            }
+
+            prefab.weapons.push_back({
+                .type = *weapon_result,
+                .offset = raylib::Vector2{weapon.x, weapon.y},
+                .munition = get_texture_id(data.munition),
+                .damage = data.damage,
+                .lifetime = data.lifetime,
+                .cooldown = data.cooldown,
+                .radius = data.radius,
+                .collision_layer = layer.value_or(CollisionLayers::k_no_layer),
+            });
+        }
+
+        prefab.engines.reserve(ship.engines.size());
+        for (const auto& engine : ship.engines) {
+            const auto engine_result = get_engine(engine.engine_type);
+            if (!engine_result) {
+                H_WARNING("Asset Loader", "Ship '{}' will be missing an engine: {}", key, engine_result.error());
+                continue;
+            }
+
+            const auto data = *engine_result;
+            prefab.engines.push_back({
+                .offset = raylib::Vector2{engine.x, engine.y},
+                .texture = get_texture(data->texture),
+                .thrust = data->thrust,
+            });
+            prefab.thrust += data->thrust;
+            prefab.rotation += data->rotation;
+        }
+
+        m_ship_ids.emplace(key, ShipId{static_cast<uint32_t>(m_ship_prefabs.size())});
+        m_ship_prefabs.push_back(std::move(prefab));
+    }
+}
+
 void AssetManager::unload_all() {
     for (auto& texture : m_textures) {
         texture.Unload();
@@ -517,10 +1215,15 @@ void AssetManager::unload_all() {
     m_textures.clear();
     m_texture_map.clear();
     m_ship_assets.clear();
+    m_ship_prefabs.clear();
+    m_ship_ids.clear();
+    m_weapons.clear();
+    m_weapon_ids.clear();
     m_weapon_assets.clear();
     m_engine_assets.clear();
     m_map_assets.clear();
     m_start_assets.clear();
+    m_raw_collision_data.clear();
 }
 
 raylib::TextureUnmanaged& AssetManager::get_error_texture() {
@@ -2,18 +2,27 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <expected>
 #include <filesystem>
+#include <optional>
 #include <print>
 #include <unordered_map>
 #include <string>
+#include <variant>
 #include <vector>
 
 #include <nlohmann/json.hpp>
 #include <pugixml.hpp>
 #include <raylib-cpp.hpp>
 
+#include "AssetId.hpp"
+#include "AssetPack.hpp"
+#include "ThreadPool.hpp"
+
 using json = nlohmann::json;
 
 struct WeaponData {
@@ -22,9 +31,11 @@ struct WeaponData {
     float lifetime;
     float cooldown;
     float radius;
+    std::string collision_layer;
 
     explicit WeaponData(const json& j);
     explicit WeaponData(const pugi::xml_document& d);
+    explicit WeaponData(const AssetPack& pack, const AssetPack::WeaponRecord& record);
 };
 
 struct EngineData {
@@ -34,6 +45,7 @@ struct EngineData {
 
     explicit EngineData(const json& j);
     explicit EngineData(const pugi::xml_document& d);
+    explicit EngineData(const AssetPack& pack, const AssetPack::EngineRecord& record);
 };
 
 struct ShipEngineData {
@@ -52,11 +64,13 @@ struct ShipData {
     std::string texture;
     float max_speed;
     float radius;
+    std::string collision_layer;
     std::vector<ShipWeaponData> weapons;
     std::vector<ShipEngineData> engines;
     
     explicit ShipData(const json& j);
     explicit ShipData(const pugi::xml_document& d);
+    explicit ShipData(const AssetPack& pack, const AssetPack::ShipRecord& record);
 };
 
 struct MapData {
@@ -90,6 +104,7 @@ struct MapData {
 
     explicit MapData(const json& j);
     explicit MapData(const pugi::xml_document& d);
+    explicit MapData(const AssetPack& pack, const AssetPack::MapRecord& record);
 };
 
 struct StartData {
@@ -105,6 +120,7 @@ struct StartData {
 
     explicit StartData(const json& j);
     explicit StartData(const pugi::xml_document& d);
+    explicit StartData(const AssetPack& pack, const AssetPack::StartRecord& record);
 };
 
 struct AffiliationData {
@@ -118,20 +134,101 @@ struct AffiliationData {
 
     explicit AffiliationData(const json& j);
     explicit AffiliationData(const pugi::xml_document& d);
+    explicit AffiliationData(const AssetPack& pack, const AssetPack::AffiliationRecord& record);
+};
+
+struct CollisionData {
+    struct Interaction {
+        std::string first;
+        std::string second;
+    };
+
+    std::vector<std::string> layers;
+    std::vector<Interaction> interactions;
+
+    explicit CollisionData(const json& j);
+    explicit CollisionData(const pugi::xml_document& d);
+    explicit CollisionData(const AssetPack& pack, const AssetPack::CollisionRecord& record);
+};
+
+// Every CollisionData compiled into one table. Layer i collides with layer j when bit j of masks[i] is set.
+struct CollisionLayers {
+    static constexpr std::size_t k_max_layers = 32;
+
+    // Given to colliders whose layer couldn't be resolved. They never collide with anything.
+    static constexpr uint32_t k_no_layer = UINT32_MAX;
+
+    std::vector<std::string> names;
+    std::array<uint32_t, k_max_layers> masks{};
+};
+
+// The prefabs are ShipData and what it refers to with every name already resolved. They're compiled once in load_assets,
+// so spawning from one never has to look anything up.
+struct WeaponPrefab {
+    WeaponId type;
+    raylib::Vector2 offset;
+    TextureId munition;
+    float damage;
+    float lifetime;
+    float cooldown;
+    float radius;
+    uint32_t collision_layer;
+};
+
+struct EnginePrefab {
+    raylib::Vector2 offset;
+    raylib::TextureUnmanaged texture;
+    float thrust;
+};
+
+struct ShipPrefab {
+    raylib::TextureUnmanaged texture;
+    float max_speed;
+    float radius;
+    uint32_t collision_layer;
+    // Summed over every engine.
+    float thrust;
+    float rotation;
+    std::vector<WeaponPrefab> weapons;
+    std::vector<EnginePrefab> engines;
 };
 
 class AssetManager {
 public:
+    // Where load_assets looks for a pack from horizons_cook before falling back to the loose files in ./assets/.
+    static constexpr const char* k_pack_path = "./assets.hzpack";
+    static constexpr const char* k_assets_path = "./assets/";
+
     ~AssetManager();
 
-    void load_assets();
+    // Without textures nothing touches the GPU, so this can run before a window exists or without one at all.
+    // get_texture then hands out an empty texture instead.
+    // With a thread pool, files are found, read, parsed, and decoded across it. Textures are still uploaded on this thread.
+    void load_assets(bool load_textures = true, ThreadPool* thread_pool = nullptr);
+
+    // Loads the loose files in ./assets/, and writes them along with every texture's file to a pack at path.
+    // Throws if anything can't be read or written.
+    void cook_pack(const std::filesystem::path& path, ThreadPool* thread_pool = nullptr);
 
     [[nodiscard]]
     std::expected<const ShipData*, std::string> get_ship(const std::string& name) const;
 
+    [[nodiscard]]
+    std::expected<ShipId, std::string> get_ship_id(const std::string& name) const;
+
+    // Ids come from get_ship_id, so they're always valid.
+    [[nodiscard]]
+    const ShipPrefab& get_ship_prefab(ShipId id) const;
+
     [[nodiscard]]
     std::expected<const WeaponData*, std::string> get_weapon(const std::string& name) const;
 
+    [[nodiscard]]
+    std::expected<WeaponId, std::string> get_weapon_id(const std::string& name) const;
+
+    [[nodiscard]]
+    const WeaponData& get_weapon(WeaponId id) const;
+
     [[nodiscard]]
     std::expected<const EngineData*, std::string> get_engine(const std::string& name) const;
 
@@ -144,24 +241,82 @@ public:
     [[nodiscard]]
     raylib::TextureUnmanaged& get_texture(const std::string& name);
 
+    // An invalid id gets the same stand-in texture as a name that wasn't found.
     [[nodiscard]]
-    std::expected<const uint32_t, std::string>get_faction_id(const std::string& name) const;
+    raylib::TextureUnmanaged& get_texture(TextureId id);
 
     [[nodiscard]]
-    std::expected<const int, std::string>get_relation(uint32_t base_faction, uint32_t sub_faction) const;
+    TextureId get_texture_id(const std::string& name) const;
+
+    [[nodiscard]]
+    std::expected<FactionId, std::string> get_faction_id(const std::string& name) const;
+
+    [[nodiscard]]
+    std::expected<const int, std::string>get_relation(FactionId base_faction, FactionId sub_faction) const;
+
+    // Whether two factions would shoot each other. Cheap enough for the broadphase to call per pair.
+    // Ids that don't belong to a faction are never hostile.
+    [[nodiscard]]
+    bool is_hostile(const FactionId faction_a, const FactionId faction_b) const noexcept {
+        const std::size_t row = std::min<std::size_t>(faction_a.index, m_faction_count);
+        const std::size_t column = std::min<std::size_t>(faction_b.index, m_faction_count);
+        return (m_hostility[row * m_hostility_words + column / 64] >> (column % 64)) & 1u;
+    }
+
+    [[nodiscard]]
+    std::expected<const uint32_t, std::string>get_collision_layer(const std::string& name) const;
+
+    [[nodiscard]]
+    const CollisionLayers& get_collision_layers() const;
 
 private:
+    enum class AssetKind {
+        Start,
+        Map,
+        Engine,
+        Weapon,
+        Ship,
+        Affiliation,
+        Collision,
+        Texture
+    };
+
+    struct AssetFile {
+        std::filesystem::path path;
+        AssetKind kind;
+        // From the file name. Starts and maps go by the name inside them instead.
+        std::string name;
+    };
+
+    // What a worker made of one file. Images are only decoded, since uploading them has to wait for the main thread.
+    struct LoadedAsset {
+        std::variant<
+            std::monostate, StartData, MapData, EngineData, WeaponData, ShipData, AffiliationData, CollisionData, Image
+        > data;
+        std::string error;
+    };
+
     std::unordered_map<std::string, ShipData> m_ship_assets;
+    std::vector<ShipPrefab> m_ship_prefabs;
+    std::unordered_map<std::string, ShipId> m_ship_ids;
     std::unordered_map<std::string, WeaponData> m_weapon_assets;
+    std::vector<const WeaponData*> m_weapons;
+    std::unordered_map<std::string, WeaponId> m_weapon_ids;
     std::unordered_map<std::string, EngineData> m_engine_assets;
     std::unordered_map<std::string, MapData> m_map_assets;
     std::unordered_map<std::string, StartData> m_start_assets;
     std::vector<AffiliationData> m_raw_affiliations;
     std::unordered_map<std::string, int> m_faction_name_to_id;
     std::vector<std::string> m_faction_id_to_name;
-    std::vector<std::vector<int>> m_relation_table;
+    std::size_t m_faction_count = 0;
+    std::vector<int> m_relation_table;
+    std::size_t m_hostility_words = 1;
+    std::vector<uint64_t> m_hostility = {0};
+    std::vector<CollisionData> m_raw_collision_data;
+    CollisionLayers m_collision_layers;
     std::vector<raylib::TextureUnmanaged> m_textures;
     std::unordered_map<std::string, size_t> m_texture_map;
+    bool m_textures_loaded = false;
 
     static bool is_xml(const std::filesystem::directory_entry& entry);
 
@@ -177,6 +332,35 @@ private:
 
     static std::string get_texture_name(const std::filesystem::directory_entry& entry);
 
+    [[nodiscard]]
+    static std::optional<AssetFile> get_asset_file(const std::filesystem::directory_entry& entry, bool load_textures);
+
+    // Every asset file under directory, sorted by path. Each folder at the top is walked as its own job.
+    [[nodiscard]]
+    static std::vector<AssetFile> scan_assets(const std::filesystem::path& directory, bool load_textures, ThreadPool* thread_pool);
+
+    // A hash of the path, size, and modification time of every file under directory. Cheap next to loading them, and
+    // changes whenever any of them is added, removed, or saved.
+    [[nodiscard]]
+    static uint64_t fingerprint_assets(const std::filesystem::path& directory);
+
+    // Safe to call from any thread.
+    [[nodiscard]]
+    static LoadedAsset load_asset(const AssetFile& file);
+
+    void store_asset(const AssetFile& file, LoadedAsset& asset);
+
+    void load_loose_files(bool load_textures, ThreadPool* thread_pool);
+
+    void load_pack(const AssetPack& pack, bool load_textures, ThreadPool* thread_pool);
+
+    void compile_hostility();
+
+    void compile_collision_layers();
+
+    // Needs textures and collision layers to already be in place. Hands out weapon and ship ids along the way.
+    void compile_ship_prefabs();
+
     void unload_all();
 
     static raylib::TextureUnmanaged& get_error_texture();
@@ -0,0 +1,194 @@
+// Copyright 2025 RestingImmortal
+
+#include "AssetPack.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr std::size_t k_table_alignment = 8;
+
+    template <typename Record>
+    bool fits(const AssetPack::Table& table, const std::size_t file_size) {
+        return
+            table.offset % alignof(Record) == 0 &&
+            table.offset <= file_size &&
+            table.count <= (file_size - table.offset) / sizeof(Record);
+    }
+
+    // Appends records to the file image, starting at the next aligned offset.
+    template <typename Record>
+    AssetPack::Table append(std::vector<std::byte>& file, const std::vector<Record>& records) {
+        static_assert(std::is_trivially_copyable_v<Record>);
+
+        file.resize((file.size() + k_table_alignment - 1) / k_table_alignment * k_table_alignment);
+        const AssetPack::Table table = {file.size(), records.size()};
+
+        const auto* bytes = reinterpret_cast<const std::byte*>(records.data());
+        file.insert(file.end(), bytes, bytes + records.size() * sizeof(Record));
+        return table;
+    }
+}
+
+// Public Methods
+
+AssetPack::String AssetPack::Contents::add_string(const std::string_view string) {
+    if (const auto it = m_string_ids.find(std::string(string)); it != m_string_ids.end()) {
+        return it->second;
+    }
+
+    const String id = {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(string.size())};
+    strings += string;
+    m_string_ids.emplace(string, id);
+    return id;
+}
+
+AssetPack::AssetPack(const std::filesystem::path& path) {
+#ifndef _WIN32
+    if (const int file = ::open(path.c_str(), O_RDONLY); file >= 0) {
+        struct stat status{};
+        if (::fstat(file, &status) == 0 && status.st_size > 0) {
+            void* data = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            if (data != MAP_FAILED) {
+                m_data = static_cast<const std::byte*>(data);
+                m_size = static_cast<std::size_t>(status.st_size);
+                m_mapped = true;
+            }
+        }
+        // The mapping stays valid after the file is closed.
+        ::close(file);
+    }
+#endif
+
+    // Somewhere mmap doesn't work, so read the whole thing in instead.
+    if (!m_mapped) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return;
+        }
+        const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        m_buffer.resize(bytes.size());
+        std::memcpy(m_buffer.data(), bytes.data(), bytes.size());
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+
+    if (!is_valid()) {
+        close();
+    }
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::is_open() const {
+    return m_data != nullptr;
+}
+
+const AssetPack::Header& AssetPack::get_header() const {
+    return *reinterpret_cast<const Header*>(m_data);
+}
+
+std::string_view AssetPack::get_string(const String string) const {
+    const Table& pool = get_header().strings;
+    if (string.offset > pool.count || string.length > pool.count - string.offset) {
+        return {};
+    }
+    return {reinterpret_cast<const char*>(m_data + pool.offset + string.offset), string.length};
+}
+
+std::span<const std::byte> AssetPack::get_texture_bytes(const TextureRecord& texture) const {
+    const Table& blobs = get_header().blobs;
+    if (texture.offset > blobs.count || texture.size > blobs.count - texture.offset) {
+        return {};
+    }
+    return {m_data + blobs.offset + texture.offset, static_cast<std::size_t>(texture.size)};
+}
+
+bool AssetPack::write(const std::filesystem::path& path, const Contents& contents) {
+    std::vector<std::byte> file(sizeof(Header));
+
+    Header header = {
+        .magic = k_magic,
+        .version = k_version,
+        .reserved = 0,
+        .source_fingerprint = contents.source_fingerprint,
+        .weapons = append(file, contents.weapons),
+        .engines = append(file, contents.engines),
+        .ships = append(file, contents.ships),
+        .ship_parts = append(file, contents.ship_parts),
+        .maps = append(file, contents.maps),
+        .map_backgrounds = append(file, contents.map_backgrounds),
+        .map_ships = append(file, contents.map_ships),
+        .map_objects = append(file, contents.map_objects),
+        .starts = append(file, contents.starts),
+        .affiliations = append(file, contents.affiliations),
+        .relations = append(file, contents.relations),
+        .collisions = append(file, contents.collisions),
+        .collision_layers = append(file, contents.collision_layers),
+        .collision_interactions = append(file, contents.collision_interactions),
+        .textures = append(file, contents.textures),
+        .strings = append(file, std::vector<char>(contents.strings.begin(), contents.strings.end())),
+        .blobs = append(file, contents.blobs),
+    };
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    std::FILE* stream = std::fopen(path.string().c_str(), "wb");
+    if (!stream) {
+        return false;
+    }
+    const bool written = std::fwrite(file.data(), 1, file.size(), stream) == file.size();
+    return std::fclose(stream) == 0 && written;
+}
+
+// Private Methods
+
+void AssetPack::close() {
+#ifndef _WIN32
+    if (m_mapped) {
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_buffer.clear();
+}
+
+bool AssetPack::is_valid() const {
+    if (!m_data || m_size < sizeof(Header)) {
+        return false;
+    }
+
+    const Header& header = get_header();
+    return
+        header.magic == k_magic &&
+        header.version == k_version &&
+        fits<WeaponRecord>(header.weapons, m_size) &&
+        fits<EngineRecord>(header.engines, m_size) &&
+        fits<ShipRecord>(header.ships, m_size) &&
+        fits<ShipPartRecord>(header.ship_parts, m_size) &&
+        fits<MapRecord>(header.maps, m_size) &&
+        fits<BackgroundRecord>(header.map_backgrounds, m_size) &&
+        fits<MapShipRecord>(header.map_ships, m_size) &&
+        fits<ObjectRecord>(header.map_objects, m_size) &&
+        fits<StartRecord>(header.starts, m_size) &&
+        fits<AffiliationRecord>(header.affiliations, m_size) &&
+        fits<RelationRecord>(header.relations, m_size) &&
+        fits<CollisionRecord>(header.collisions, m_size) &&
+        fits<String>(header.collision_layers, m_size) &&
+        fits<InteractionRecord>(header.collision_interactions, m_size) &&
+        fits<TextureRecord>(header.textures, m_size) &&
+        fits<char>(header.strings, m_size) &&
+        fits<std::byte>(header.blobs, m_size);
+}
@@ -0,0 +1,259 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Every asset cooked into one file by horizons_cook, so loading is reading tables instead of parsing text.
+//
+// The file is a Header, then one flat table of records per kind of asset, then a pool of strings, then the raw bytes
+// of every texture. Records refer to strings and texture bytes by offset, and to their children (a ship's weapons, a
+// map's ships, ...) by a Slice of another table. Nothing in the file is a pointer, so it can be used straight from a
+// memory mapping.
+class AssetPack {
+public:
+    static constexpr std::array<char, 8> k_magic = {'H', 'Z', 'P', 'A', 'C', 'K', '\0', '\0'};
+    static constexpr uint32_t k_version = 2;
+
+    // Somewhere in the string pool.
+    struct String {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    // Records [first, first + count) of some other table.
+    struct Slice {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    // Where a table is in the file, and how many records it has.
+    struct Table {
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t reserved;
+        // Of the assets directory the pack was cooked from, see AssetManager::fingerprint_assets.
+        uint64_t source_fingerprint;
+
+        Table weapons;
+        Table engines;
+        Table ships;
+        Table ship_parts;
+        Table maps;
+        Table map_backgrounds;
+        Table map_ships;
+        Table map_objects;
+        Table starts;
+        Table affiliations;
+        Table relations;
+        Table collisions;
+        Table collision_layers;
+        Table collision_interactions;
+        Table textures;
+
+        // Counted in bytes.
+        Table strings;
+        Table blobs;
+    };
+
+    struct WeaponRecord {
+        String name;
+        String munition;
+        String collision_layer;
+        float damage;
+        float lifetime;
+        float cooldown;
+        float radius;
+    };
+
+    struct EngineRecord {
+        String name;
+        String texture;
+        float thrust;
+        float rotation;
+    };
+
+    struct ShipRecord {
+        String name;
+        String texture;
+        String collision_layer;
+        float max_speed;
+        float radius;
+        Slice weapons; // Of ship_parts.
+        Slice engines; // Of ship_parts.
+    };
+
+    // A weapon or engine mounted on a ship.
+    struct ShipPartRecord {
+        String type;
+        float x;
+        float y;
+    };
+
+    struct MapRecord {
+        String name;
+        Slice backgrounds;
+        Slice ships;
+        Slice objects;
+    };
+
+    struct BackgroundRecord {
+        String image;
+        int32_t layer;
+    };
+
+    struct MapShipRecord {
+        String ship_type;
+        String affiliation;
+        float x;
+        float y;
+    };
+
+    struct ObjectRecord {
+        String texture;
+        float x;
+        float y;
+        int32_t layer;
+    };
+
+    struct StartRecord {
+        String name;
+        String initial_map;
+        String player_ship_type;
+        float player_x;
+        float player_y;
+    };
+
+    struct AffiliationRecord {
+        String name;
+        Slice relations;
+    };
+
+    struct RelationRecord {
+        String faction;
+        int32_t relation;
+    };
+
+    struct CollisionRecord {
+        Slice layers;       // Of collision_layers.
+        Slice interactions; // Of collision_interactions.
+    };
+
+    struct InteractionRecord {
+        String first;
+        String second;
+    };
+
+    struct TextureRecord {
+        String name;
+        uint64_t offset; // Into the blobs.
+        uint64_t size;
+    };
+
+    // Everything that goes into a pack, built up by the cook before write lays it out.
+    struct Contents {
+        std::vector<WeaponRecord> weapons;
+        std::vector<EngineRecord> engines;
+        std::vector<ShipRecord> ships;
+        std::vector<ShipPartRecord> ship_parts;
+        std::vector<MapRecord> maps;
+        std::vector<BackgroundRecord> map_backgrounds;
+        std::vector<MapShipRecord> map_ships;
+        std::vector<ObjectRecord> map_objects;
+        std::vector<StartRecord> starts;
+        std::vector<AffiliationRecord> affiliations;
+        std::vector<RelationRecord> relations;
+        std::vector<CollisionRecord> collisions;
+        std::vector<String> collision_layers;
+        std::vector<InteractionRecord> collision_interactions;
+        std::vector<TextureRecord> textures;
+        std::string strings;
+        std::vector<std::byte> blobs;
+        uint64_t source_fingerprint = 0;
+
+        // Identical strings are only stored once.
+        String add_string(std::string_view string);
+
+        // Adds to the end of table, and returns where it went.
+        template <typename Record>
+        static Slice add_slice(std::vector<Record>& table, const std::vector<Record>& records) {
+            const Slice slice = {static_cast<uint32_t>(table.size()), static_cast<uint32_t>(records.size())};
+            table.insert(table.end(), records.begin(), records.end());
+            return slice;
+        }
+
+    private:
+        std::unordered_map<std::string, String> m_string_ids;
+    };
+
+    // Maps the pack at path. Nothing is loaded if the file is missing, damaged, or from another version, and is_open
+    // says whether it was.
+    explicit AssetPack(const std::filesystem::path& path);
+
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    [[nodiscard]]
+    bool is_open() const;
+
+    [[nodiscard]]
+    const Header& get_header() const;
+
+    // Tables were bounds checked when the pack was opened.
+    template <typename Record>
+    [[nodiscard]]
+    std::span<const Record> get_table(const Table& table) const {
+        static_assert(std::is_trivially_copyable_v<Record>);
+        return {reinterpret_cast<const Record*>(m_data + table.offset), static_cast<std::size_t>(table.count)};
+    }
+
+    // A slice that runs off the end of its table comes back empty.
+    template <typename Record>
+    [[nodiscard]]
+    std::span<const Record> get_slice(const Table& table, const Slice slice) const {
+        const auto records = get_table<Record>(table);
+        if (slice.first > records.size() || slice.count > records.size() - slice.first) {
+            return {};
+        }
+        return records.subspan(slice.first, slice.count);
+    }
+
+    // As does a string outside of the pool.
+    [[nodiscard]]
+    std::string_view get_string(String string) const;
+
+    [[nodiscard]]
+    std::span<const std::byte> get_texture_bytes(const TextureRecord& texture) const;
+
+    // Returns false if the file couldn't be written.
+    static bool write(const std::filesystem::path& path, const Contents& contents);
+
+private:
+    const std::byte* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_mapped = false;
+
+    // Used instead of a mapping where there isn't one.
+    std::vector<std::byte> m_buffer;
+
+    void close();
+
+    [[nodiscard]]
+    bool is_valid() const;
+};
@@ -0,0 +1,166 @@
+// Copyright 2025 RestingImmortal
+
+#include "BinaryLog.hpp"
+
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Public Methods
+
+BinaryLog::BinaryLog(const std::filesystem::path& path) : m_start(std::chrono::steady_clock::now()) {
+    Header header = {
+        .magic = k_magic,
+        .version = k_version,
+        .window_size = 0,
+        .start_unix_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count()
+    };
+
+#ifndef _WIN32
+    m_file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_file >= 0) {
+        if (Window* window = map_window(0)) {
+            header.window_size = static_cast<uint32_t>(k_window_size);
+            std::memcpy(window->data, &header, sizeof(header));
+            window->used.store(sizeof(header), std::memory_order_relaxed);
+            m_window.store(window, std::memory_order_release);
+            return;
+        }
+
+        // Somewhere mmap doesn't work, so fall back to writing normally.
+        ::close(m_file);
+        m_file = -1;
+    }
+#endif
+
+    m_stream = std::fopen(path.string().c_str(), "wb");
+    if (m_stream) {
+        std::fwrite(&header, sizeof(header), 1, m_stream);
+    }
+}
+
+BinaryLog::~BinaryLog() {
+    std::scoped_lock lock(m_mutex);
+
+#ifndef _WIN32
+    if (Window* window = m_window.exchange(nullptr)) {
+        while (window->writers.load() != 0) {
+            std::this_thread::yield();
+        }
+
+        // Cut off the unused end of the last window, so the file is only as long as what was written.
+        const uint64_t length = window->file_offset + std::min(window->used.load(), k_window_size);
+        unmap_window(window);
+        if (::ftruncate(m_file, static_cast<off_t>(length)) != 0) {
+            // Only costs trailing zeroes, which the decoder skips anyway.
+        }
+    }
+    if (m_file >= 0) {
+        ::close(m_file);
+    }
+#endif
+
+    if (m_stream) {
+        std::fclose(m_stream);
+    }
+}
+
+bool BinaryLog::is_open() const {
+    return m_window.load(std::memory_order_relaxed) != nullptr || m_stream != nullptr;
+}
+
+void BinaryLog::write_site(
+    const uint32_t id,
+    const uint8_t level,
+    const std::string_view context,
+    const std::string_view format,
+    const std::string_view file,
+    const uint32_t line
+) {
+    write_line(k_site_record, id, level, context, format, file, line);
+}
+
+uint64_t BinaryLog::get_dropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+// Private Methods
+
+void BinaryLog::write(const std::byte* data, const std::size_t size) {
+    if (m_stream) {
+        std::scoped_lock lock(m_mutex);
+        std::fwrite(data, 1, size, m_stream);
+        return;
+    }
+
+    while (true) {
+        Window* window = m_window.load();
+        if (!window) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Announced before checking the window is still current, so advance can't unmap it from under this write.
+        window->writers.fetch_add(1);
+        if (m_window.load() != window) {
+            window->writers.fetch_sub(1);
+            continue;
+        }
+
+        const std::size_t offset = window->used.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size <= k_window_size) {
+            std::memcpy(window->data + offset, data, size);
+            window->writers.fetch_sub(1, std::memory_order_release);
+            return;
+        }
+
+        window->writers.fetch_sub(1, std::memory_order_release);
+        advance(window);
+    }
+}
+
+void BinaryLog::advance(Window* full) {
+    std::scoped_lock lock(m_mutex);
+    if (m_window.load() != full) {
+        return;
+    }
+
+    // If the file can't grow, the window goes null and everything after is dropped.
+    m_window.store(map_window(full->file_offset + k_window_size));
+
+    while (full->writers.load() != 0) {
+        std::this_thread::yield();
+    }
+    unmap_window(full);
+}
+
+BinaryLog::Window* BinaryLog::map_window([[maybe_unused]] const uint64_t file_offset) {
+#ifndef _WIN32
+    if (::ftruncate(m_file, static_cast<off_t>(file_offset + k_window_size)) != 0) {
+        return nullptr;
+    }
+
+    void* data = ::mmap(nullptr, k_window_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, static_cast<off_t>(file_offset));
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+
+    return new Window{static_cast<std::byte*>(data), file_offset, 0, 0};
+#else
+    return nullptr;
+#endif
+}
+
+void BinaryLog::unmap_window([[maybe_unused]] Window* window) {
+#ifndef _WIN32
+    ::munmap(window->data, k_window_size);
+    window->data = nullptr;
+    m_retired.emplace_back(window);
+#endif
+}
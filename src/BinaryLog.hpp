@@ -0,0 +1,207 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Log lines as they were passed in rather than as text: which call site logged them, when, and the raw arguments.
+// Formatting is left to horizons_logdecode, so logging costs a few copies instead of a std::format.
+//
+// The file starts with a Header, followed by records. Every record is a RecordHeader and then its arguments,
+// each one an ArgType byte and the value. Call sites are described by records of their own, using k_site_record.
+// On POSIX the file is written through memory mapped windows, and elsewhere through plain buffered writes.
+class BinaryLog {
+public:
+    static constexpr std::array<char, 8> k_magic = {'H', 'Z', 'B', 'L', 'O', 'G', '\0', '\0'};
+    static constexpr uint32_t k_version = 1;
+
+    // Records longer than this have their strings cut short.
+    static constexpr std::size_t k_max_record = 1024;
+
+    // A site record's arguments are its id, level, context, format, file, and line.
+    static constexpr uint32_t k_site_record = UINT32_MAX;
+
+    static constexpr std::size_t k_window_size = std::size_t{16} << 20;
+
+    enum class ArgType : uint8_t {
+        Int,     // int64_t
+        UInt,    // uint64_t
+        Float,   // float
+        Double,  // double
+        Bool,    // uint8_t
+        Char,    // char
+        String   // uint32_t length, then the characters
+    };
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        // Records never cross a multiple of this. A zero length means the rest of the window is unused.
+        // Zero when the file wasn't written in windows.
+        uint32_t window_size;
+        int64_t start_unix_ns;
+    };
+
+    struct RecordHeader {
+        uint32_t length; // Including this header.
+        uint32_t site;
+        uint64_t time_ns; // Since start_unix_ns.
+    };
+
+    // Nothing gets written if the file can't be opened. is_open says whether it was.
+    explicit BinaryLog(const std::filesystem::path& path);
+
+    ~BinaryLog();
+
+    BinaryLog(const BinaryLog&) = delete;
+    BinaryLog& operator=(const BinaryLog&) = delete;
+
+    [[nodiscard]]
+    bool is_open() const;
+
+    template <typename... Args>
+    void write_line(const uint32_t site, const Args&... args) {
+        Record record(site, m_start);
+        (record.put(args), ...);
+        write(record.data(), record.size());
+    }
+
+    void write_site(
+        uint32_t id, uint8_t level, std::string_view context, std::string_view format, std::string_view file, uint32_t line
+    );
+
+    // Records lost because the file couldn't grow any more.
+    [[nodiscard]]
+    uint64_t get_dropped() const;
+
+private:
+    // Builds one record on the stack, so the file only sees a single copy of it.
+    class Record {
+    public:
+        Record(const uint32_t site, const std::chrono::steady_clock::time_point start) {
+            const RecordHeader header = {
+                .length = 0,
+                .site = site,
+                .time_ns = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()
+                )
+            };
+            std::memcpy(m_bytes.data(), &header, sizeof(header));
+            m_size = sizeof(header);
+        }
+
+        template <typename T>
+        void put(const T& value) {
+            using Value = std::remove_cvref_t<T>;
+
+            if constexpr (std::same_as<Value, bool>) {
+                put_value(ArgType::Bool, static_cast<uint8_t>(value));
+            } else if constexpr (std::same_as<Value, char>) {
+                put_value(ArgType::Char, value);
+            } else if constexpr (std::is_enum_v<Value>) {
+                put(static_cast<std::underlying_type_t<Value>>(value));
+            } else if constexpr (std::signed_integral<Value>) {
+                put_value(ArgType::Int, static_cast<int64_t>(value));
+            } else if constexpr (std::unsigned_integral<Value>) {
+                put_value(ArgType::UInt, static_cast<uint64_t>(value));
+            } else if constexpr (std::same_as<Value, float>) {
+                put_value(ArgType::Float, value);
+            } else if constexpr (std::floating_point<Value>) {
+                put_value(ArgType::Double, static_cast<double>(value));
+            } else if constexpr (std::convertible_to<const T&, std::string_view>) {
+                put_string(std::string_view(value));
+            } else {
+                // Anything else is formatted here after all. Uncommon enough not to matter.
+                std::array<char, 128> text{};
+                const auto result = std::format_to_n(text.data(), text.size(), "{}", value);
+                put_string(std::string_view(text.data(), std::min<std::size_t>(result.size, text.size())));
+            }
+        }
+
+        [[nodiscard]]
+        const std::byte* data() {
+            const auto length = static_cast<uint32_t>(m_size);
+            std::memcpy(m_bytes.data(), &length, sizeof(length));
+            return m_bytes.data();
+        }
+
+        [[nodiscard]]
+        std::size_t size() const {
+            return m_size;
+        }
+
+    private:
+        std::array<std::byte, k_max_record> m_bytes;
+        std::size_t m_size;
+
+        template <typename T>
+        void put_value(const ArgType type, const T value) {
+            if (m_size + 1 + sizeof(T) > m_bytes.size()) {
+                return;
+            }
+            m_bytes[m_size] = static_cast<std::byte>(type);
+            std::memcpy(m_bytes.data() + m_size + 1, &value, sizeof(T));
+            m_size += 1 + sizeof(T);
+        }
+
+        void put_string(const std::string_view text) {
+            constexpr std::size_t overhead = 1 + sizeof(uint32_t);
+            if (m_size + overhead > m_bytes.size()) {
+                return;
+            }
+            const auto length = static_cast<uint32_t>(std::min(text.size(), m_bytes.size() - m_size - overhead));
+            m_bytes[m_size] = static_cast<std::byte>(ArgType::String);
+            std::memcpy(m_bytes.data() + m_size + 1, &length, sizeof(length));
+            std::memcpy(m_bytes.data() + m_size + overhead, text.data(), length);
+            m_size += overhead + length;
+        }
+    };
+
+    struct Window {
+        std::byte* data;
+        uint64_t file_offset;
+        std::atomic<std::size_t> used;
+        std::atomic<uint32_t> writers;
+    };
+
+    std::chrono::steady_clock::time_point m_start;
+    std::atomic<uint64_t> m_dropped = 0;
+    std::mutex m_mutex;
+
+    // Memory mapped output. m_window is null once the file is closed or can't grow.
+    int m_file = -1;
+    std::atomic<Window*> m_window = nullptr;
+
+    // Windows that were written out. Their data is unmapped, but a writer may still be holding on to one to check
+    // whether it's current, so they're kept around until the log closes. Guarded by m_mutex.
+    std::vector<std::unique_ptr<Window>> m_retired;
+
+    // Fallback output, guarded by m_mutex.
+    std::FILE* m_stream = nullptr;
+
+    void write(const std::byte* data, std::size_t size);
+
+    // Moves writing on from full to the next window of the file. Whoever gets here first does it.
+    void advance(Window* full);
+
+    [[nodiscard]]
+    Window* map_window(uint64_t file_offset);
+
+    // Only unmaps the data. The Window itself goes to m_retired.
+    void unmap_window(Window* window);
+};
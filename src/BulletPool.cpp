@@ -0,0 +1,83 @@
+// Copyright 2025 RestingImmortal
+
+#include "BulletPool.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include "AssetManager.hpp"
+#include "Components.hpp"
+#include "SimClock.hpp"
+
+// Public Methods
+
+BulletPool::BulletPool(const std::size_t max_parked) : m_max_parked(max_parked) {}
+
+entt::entity BulletPool::acquire(entt::registry& registry) {
+    // Anything destroyed from under the pool, say by a level being torn down, is just dropped.
+    while (!m_parked.empty() && m_parked.front().released_tick + k_min_parked_ticks <= SimClock::ticks()) {
+        const auto bullet = m_parked.front().bullet;
+        m_parked.pop_front();
+
+        if (registry.valid(bullet)) {
+            registry.remove<Components::ShouldNotRender>(bullet);
+            m_stats.hits++;
+            m_stats.parked = m_parked.size();
+            return bullet;
+        }
+    }
+
+    m_stats.misses++;
+    m_stats.parked = m_parked.size();
+    return entt::null;
+}
+
+void BulletPool::release(entt::registry& registry, const entt::entity bullet) {
+    auto& bullet_component = registry.get<Components::Bullet>(bullet);
+    if (!bullet_component.despawn_timer.is_active()) {
+        return;
+    }
+    bullet_component.despawn_timer.stop();
+
+    if (m_parked.size() >= m_max_parked) {
+        registry.emplace_or_replace<Components::DespawnMarker>(bullet);
+        m_stats.destroyed++;
+        return;
+    }
+
+    registry.get<Components::Physics>(bullet).velocity = {0.0f, 0.0f};
+    registry.get<Components::Collider>(bullet).layer = CollisionLayers::k_no_layer;
+    registry.emplace_or_replace<Components::ShouldNotRender>(bullet);
+
+    m_parked.push_back({bullet, SimClock::ticks()});
+    m_stats.parked = m_parked.size();
+    m_stats.high_water = std::max(m_stats.high_water, m_parked.size());
+}
+
+void BulletPool::schedule_expiry(const entt::entity bullet, const double deadline) {
+    m_expiries.push_back({deadline, bullet});
+    std::ranges::push_heap(m_expiries, std::ranges::greater{}, &Expiry::deadline);
+}
+
+void BulletPool::release_expired(entt::registry& registry) {
+    const double now = SimClock::now();
+
+    while (!m_expiries.empty() && m_expiries.front().deadline <= now) {
+        std::ranges::pop_heap(m_expiries, std::ranges::greater{}, &Expiry::deadline);
+        const auto bullet = m_expiries.back().bullet;
+        m_expiries.pop_back();
+
+        // Stale entries either point at a destroyed bullet, or one whose timer was stopped or restarted since.
+        if (!registry.valid(bullet)) {
+            continue;
+        }
+        if (const auto* component = registry.try_get<Components::Bullet>(bullet);
+            component && component->despawn_timer.is_done()) {
+            release(registry, bullet);
+        }
+    }
+}
+
+const BulletPool::Stats& BulletPool::get_stats() const {
+    return m_stats;
+}
@@ -0,0 +1,77 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+// Keeps spent bullets around instead of destroying them, so sustained fire doesn't keep adding to and
+// removing from every storage a bullet lives in.
+//
+// A parked bullet keeps all of its components, but can't move, collide, render, or expire:
+// its velocity is zeroed, its collider is given no layer, it's marked ShouldNotRender, and its despawn timer is stopped.
+// spawn_bullet brings it back by overwriting those components in place.
+//
+// A bullet keeps its entity id while parked, so it has to sit out a whole collision pass before being handed back out.
+// Otherwise the ContactCache still has it touching whatever it last hit, and its first hit after reviving comes through
+// as a CollisionPersist instead of a CollisionBegin.
+class BulletPool {
+public:
+    static constexpr std::size_t k_default_max_parked = 4096;
+
+    // A bullet released during tick T can be revived from tick T + k_min_parked_ticks on.
+    static constexpr uint64_t k_min_parked_ticks = 2;
+
+    struct Stats {
+        uint64_t hits = 0;      // Spawns that reused a parked bullet.
+        uint64_t misses = 0;    // Spawns that had to create one.
+        uint64_t destroyed = 0; // Bullets released while the pool was full.
+        std::size_t parked = 0;
+        std::size_t high_water = 0;
+    };
+
+    // Bullets released beyond max_parked are destroyed as normal, so a one-off burst doesn't hold memory forever.
+    explicit BulletPool(std::size_t max_parked = k_default_max_parked);
+
+    // The longest parked bullet that has sat out long enough, or entt::null if there isn't one.
+    // It's made renderable again, but everything else is left for the caller to overwrite.
+    [[nodiscard]]
+    entt::entity acquire(entt::registry& registry);
+
+    // Parks a bullet, or marks it for despawn when the pool is full. Bullets that are already parked are left alone,
+    // so a bullet that both expires and hits something in the same tick only goes in once.
+    void release(entt::registry& registry, entt::entity bullet);
+
+    // Has bullet released once the SimClock reaches deadline, which should be its despawn timer's.
+    void schedule_expiry(entt::entity bullet, double deadline);
+
+    // Releases every bullet whose despawn timer has run out. Only bullets that are actually due get looked at.
+    void release_expired(entt::registry& registry);
+
+    [[nodiscard]]
+    const Stats& get_stats() const;
+
+private:
+    struct Parked {
+        entt::entity bullet;
+        uint64_t released_tick;
+    };
+
+    std::size_t m_max_parked;
+    // Oldest first, so the front is always the first to be ready.
+    std::deque<Parked> m_parked;
+    Stats m_stats;
+
+    struct Expiry {
+        double deadline;
+        entt::entity bullet;
+    };
+
+    // Min-heap on deadline. A bullet gets an entry every time it's spawned or revived,
+    // so entries for bullets that hit something first are left to go stale.
+    std::vector<Expiry> m_expiries;
+};
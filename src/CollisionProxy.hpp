@@ -0,0 +1,30 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstdint>
+
+#include <entt/entt.hpp>
+
+#include "AssetId.hpp"
+
+// Flattened copy of a Transform + Collider pair, gathered once per tick so the broadphase
+// doesn't have to go back through the registry for every test.
+struct CollisionProxy {
+    // For colliders without an Affiliation. They're never filtered out by faction.
+    static constexpr FactionId k_no_faction{};
+
+    entt::entity entity;
+    float x;
+    float y;
+    float radius;
+    uint32_t category;
+    uint32_t collides_with;
+    FactionId faction;
+};
+
+// Indices into the proxy array, with first < second.
+struct CollisionPair {
+    uint32_t first;
+    uint32_t second;
+};
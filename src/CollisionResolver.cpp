@@ -0,0 +1,199 @@
+// Copyright 2025 RestingImmortal
+
+#include "CollisionResolver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <tuple>
+
+#include "Components.hpp"
+#include "Functions.hpp"
+#include "Logger.hpp"
+
+// Public Methods
+
+void CollisionResolver::push(const Events::CollisionBegin& event) {
+    m_pending.push_back(event);
+}
+
+void CollisionResolver::push_projectile_hit(
+    const entt::entity target,
+    const raylib::Vector2 position,
+    const float damage,
+    const FactionId faction
+) {
+    m_pending_projectiles.push_back({target, position, damage, faction});
+}
+
+void CollisionResolver::resolve(entt::registry& registry, const AssetManager& asset_manager, BulletPool& bullet_pool) {
+    gather_hits(registry);
+    m_pending.clear();
+    m_pending_projectiles.clear();
+
+    std::erase_if(m_hits, [&asset_manager](const BulletHit& hit) {
+        return !asset_manager.is_hostile(hit.bullet_faction, hit.target_faction);
+    });
+
+    // A bullet touching two ships in the same tick only gets to hit the first one.
+    // Projectiles are already down to one hit each, and all share the null bullet, so they're left out of this.
+    std::ranges::sort(m_hits, [](const BulletHit& a, const BulletHit& b) {
+        return std::tie(a.bullet, a.order) < std::tie(b.bullet, b.order);
+    });
+    const auto repeats = std::ranges::unique(m_hits, [](const BulletHit& a, const BulletHit& b) {
+        return a.bullet == b.bullet && a.bullet != entt::null;
+    });
+    m_hits.erase(repeats.begin(), repeats.end());
+
+    // Grouping by target keeps each ship's components hot while its hits are applied.
+    std::ranges::sort(m_hits, [](const BulletHit& a, const BulletHit& b) {
+        return std::tie(a.target, a.order) < std::tie(b.target, b.order);
+    });
+
+    apply_hits(registry, bullet_pool);
+
+    if (!m_hits.empty()) {
+        H_DEBUG("Collision", "Resolved {} bullet hits", m_hits.size());
+    }
+}
+
+// Private Methods
+
+void CollisionResolver::gather_hits(entt::registry& registry) {
+    m_hits.clear();
+
+    const auto& bullets = registry.storage<Components::Bullet>();
+    const auto& affiliations = registry.storage<Components::Affiliation>();
+    const auto& transforms = registry.storage<Components::Transform>();
+
+    for (uint32_t order = 0; order < m_pending.size(); order++) {
+        const auto [a, b] = m_pending[order];
+
+        // Despawning runs before events are handled, so either side may already be gone.
+        if (!registry.valid(a) || !registry.valid(b)) {
+            continue;
+        }
+
+        // Bullet against non-bullet is the only pairing with any rules so far.
+        const bool a_is_bullet = bullets.contains(a);
+        if (a_is_bullet == bullets.contains(b)) {
+            continue;
+        }
+
+        if (!affiliations.contains(a) || !affiliations.contains(b)) {
+            continue;
+        }
+
+        const auto bullet = a_is_bullet ? a : b;
+        const auto target = a_is_bullet ? b : a;
+
+        // Expired earlier this tick and already parked, see BulletPool.
+        if (!bullets.get(bullet).despawn_timer.is_active() || !transforms.contains(bullet)) {
+            continue;
+        }
+
+        m_hits.push_back({
+            .bullet = bullet,
+            .target = target,
+            .position = transforms.get(bullet).position,
+            .damage = bullets.get(bullet).damage,
+            .bullet_faction = affiliations.get(bullet).id,
+            .target_faction = affiliations.get(target).id,
+            .order = order
+        });
+    }
+
+    // Ordered after every event, so bullets win ties the same way they always have.
+    auto order = static_cast<uint32_t>(m_pending.size());
+    for (const auto& hit : m_pending_projectiles) {
+        if (!registry.valid(hit.target) || !affiliations.contains(hit.target)) {
+            continue;
+        }
+
+        m_hits.push_back({
+            .bullet = entt::null,
+            .target = hit.target,
+            .position = hit.position,
+            .damage = hit.damage,
+            .bullet_faction = hit.faction,
+            .target_faction = affiliations.get(hit.target).id,
+            .order = order++
+        });
+    }
+}
+
+void CollisionResolver::apply_hits(entt::registry& registry, BulletPool& bullet_pool) {
+    for (const auto& hit : m_hits) {
+        if (hit.bullet != entt::null) {
+            bullet_pool.release(registry, hit.bullet);
+        }
+    }
+
+    auto& hulls = registry.storage<Components::HullHealth>();
+    const auto& transforms = registry.storage<Components::Transform>();
+
+    // Only hits on something with a hull go any further.
+    std::erase_if(m_hits, [&](const BulletHit& hit) {
+        return !hulls.contains(hit.target) || !transforms.contains(hit.target);
+    });
+
+    const std::size_t hit_count = m_hits.size();
+    m_offset_x.resize(hit_count);
+    m_offset_y.resize(hit_count);
+    m_forward_x.resize(hit_count);
+    m_forward_y.resize(hit_count);
+    m_quadrants.resize(hit_count);
+
+    // Hits are grouped by target, so every ship's facing only gets worked out once.
+    auto previous_target = entt::entity{entt::null};
+    float forward_x = 0.0f;
+    float forward_y = 0.0f;
+    for (std::size_t i = 0; i < hit_count; i++) {
+        const auto& target_transform = transforms.get(m_hits[i].target);
+
+        if (m_hits[i].target != previous_target) {
+            previous_target = m_hits[i].target;
+            const float rotation_rad = target_transform.rotation * DEG2RAD;
+            forward_x = std::sin(rotation_rad);
+            forward_y = -std::cos(rotation_rad);
+        }
+
+        const raylib::Vector2 offset = m_hits[i].position - target_transform.position;
+        m_offset_x[i] = offset.x;
+        m_offset_y[i] = offset.y;
+        m_forward_x[i] = forward_x;
+        m_forward_y[i] = forward_y;
+    }
+
+    classify_hits(m_offset_x, m_offset_y, m_forward_x, m_forward_y, m_quadrants);
+
+    // Same order as HitQuadrant.
+    static constexpr std::array k_quadrant_hulls = {
+        &Components::HullHealth::hull_front,
+        &Components::HullHealth::hull_right,
+        &Components::HullHealth::hull_back,
+        &Components::HullHealth::hull_left
+    };
+
+    for (std::size_t first = 0; first < hit_count;) {
+        const auto target = m_hits[first].target;
+        auto& hull = hulls.get(target);
+
+        std::size_t last = first;
+        for (; last < hit_count && m_hits[last].target == target; last++) {
+            hull.*k_quadrant_hulls[static_cast<std::size_t>(m_quadrants[last])] -= m_hits[last].damage;
+        }
+
+        // Losing any one side is enough to take the whole ship out.
+        if (
+            (hull.hull_front <= 0.0f || hull.hull_right <= 0.0f ||
+             hull.hull_back  <= 0.0f || hull.hull_left  <= 0.0f) &&
+            !registry.all_of<Components::DespawnMarker>(target)
+        ) {
+            registry.emplace<Components::DespawnMarker>(target);
+            H_INFO("Collision", "Ship {} destroyed", entt::to_integral(target));
+        }
+
+        first = last;
+    }
+}
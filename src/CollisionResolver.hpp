@@ -0,0 +1,64 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <raylib-cpp.hpp>
+
+#include "AssetManager.hpp"
+#include "BulletPool.hpp"
+#include "Enums.hpp"
+#include "Events.hpp"
+
+// Collects the frame's collision events and deals with all of them at once,
+// instead of doing a round of registry lookups for every single event.
+class CollisionResolver {
+public:
+    // Connected to the dispatcher. Only queues the event up.
+    void push(const Events::CollisionBegin& event);
+
+    // For projectiles that aren't entities, see ProjectileManager. They go through the same filtering and damage as bullets.
+    void push_projectile_hit(entt::entity target, raylib::Vector2 position, float damage, FactionId faction);
+
+    // Sorts the queued contacts into bullet hits, drops friendly fire, then despawns bullets and damages hulls.
+    // Ships left with any hull quadrant at zero are marked for despawn along with everything attached to them.
+    // Spent bullets go back into bullet_pool.
+    void resolve(entt::registry& registry, const AssetManager& asset_manager, BulletPool& bullet_pool);
+
+private:
+    // bullet is null for projectile hits, which have nothing to despawn.
+    struct BulletHit {
+        entt::entity bullet;
+        entt::entity target;
+        raylib::Vector2 position;
+        float damage;
+        FactionId bullet_faction;
+        FactionId target_faction;
+        uint32_t order;
+    };
+
+    struct ProjectileHit {
+        entt::entity target;
+        raylib::Vector2 position;
+        float damage;
+        FactionId faction;
+    };
+
+    std::vector<Events::CollisionBegin> m_pending;
+    std::vector<ProjectileHit> m_pending_projectiles;
+    std::vector<BulletHit> m_hits;
+
+    // Per-hit scratch for classifying quadrants, in the same order as m_hits.
+    std::vector<float> m_offset_x;
+    std::vector<float> m_offset_y;
+    std::vector<float> m_forward_x;
+    std::vector<float> m_forward_y;
+    std::vector<HitQuadrant> m_quadrants;
+
+    void gather_hits(entt::registry& registry);
+
+    void apply_hits(entt::registry& registry, BulletPool& bullet_pool);
+};
@@ -0,0 +1,329 @@
+// Copyright 2025 RestingImmortal
+
+#include "CollisionWorld.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <span>
+#include <string>
+
+#include "Components.hpp"
+#include "Logger.hpp"
+
+namespace {
+    // Below this, handing work to other threads costs more than it saves.
+    constexpr std::size_t k_min_chunk_size = 512;
+
+    // More chunks than threads, so one crowded chunk doesn't leave the rest of the pool idle.
+    constexpr std::size_t k_chunks_per_thread = 4;
+
+    uint32_t layer_of(const CollisionProxy& proxy) {
+        return static_cast<uint32_t>(std::countr_zero(proxy.category));
+    }
+}
+
+// Public Methods
+
+void CollisionWorld::set_layers(const CollisionLayers& layers) {
+    m_layer_count = static_cast<uint32_t>(layers.names.size());
+    m_layer_masks = layers.masks;
+}
+
+void CollisionWorld::set_faction_filter(const AssetManager* asset_manager) {
+    m_faction_filter = asset_manager;
+}
+
+void CollisionWorld::update(entt::registry& registry) {
+    gather_proxies(registry);
+
+    if (m_mode == BroadphaseMode::BruteForce) {
+        brute_force();
+    } else {
+        prepare_passes();
+        detect();
+    }
+
+    m_contacts.update(m_collisions);
+}
+
+const std::vector<Events::Collision>& CollisionWorld::get_collisions() const {
+    return m_collisions;
+}
+
+const ContactCache& CollisionWorld::get_contacts() const {
+    return m_contacts;
+}
+
+BroadphaseMode CollisionWorld::get_mode() const {
+    return m_mode;
+}
+
+uint64_t CollisionWorld::get_divergences() const {
+    return m_divergences;
+}
+
+// Private Methods
+
+void CollisionWorld::gather_proxies(entt::registry& registry) {
+    m_gathered.clear();
+
+    const auto view = registry.view<Components::Transform, Components::Collider>();
+    view.each([this, &registry](const auto entity, const auto& transform, const auto& collider) {
+        // Unresolved layers never collide, so they don't need to be looked at at all.
+        if (collider.layer >= m_layer_count) {
+            return;
+        }
+
+        FactionId faction = CollisionProxy::k_no_faction;
+        if (m_faction_filter) {
+            if (const auto* affiliation = registry.try_get<Components::Affiliation>(entity)) {
+                faction = affiliation->id;
+            }
+        }
+
+        m_gathered.push_back({
+            .entity = entity,
+            .x = transform.position.x,
+            .y = transform.position.y,
+            .radius = collider.radius,
+            .category = 1u << collider.layer,
+            .collides_with = m_layer_masks[collider.layer],
+            .faction = faction
+        });
+    });
+
+    // Stable counting sort by layer, so every layer ends up as one contiguous bucket.
+    m_layer_starts.fill(0);
+    for (const auto& proxy : m_gathered) {
+        m_layer_starts[layer_of(proxy) + 1]++;
+    }
+    for (std::size_t layer = 1; layer < m_layer_starts.size(); layer++) {
+        m_layer_starts[layer] += m_layer_starts[layer - 1];
+    }
+
+    auto cursors = m_layer_starts;
+    m_proxies.resize(m_gathered.size());
+    for (const auto& proxy : m_gathered) {
+        m_proxies[cursors[layer_of(proxy)]++] = proxy;
+    }
+}
+
+void CollisionWorld::brute_force() {
+    m_collisions.clear();
+
+    for (std::size_t first = 0; first < m_proxies.size(); first++) {
+        const auto& a = m_proxies[first];
+
+        for (std::size_t second = first + 1; second < m_proxies.size(); second++) {
+            const auto& b = m_proxies[second];
+
+            if (!((a.collides_with & b.category) || (b.collides_with & a.category)) || is_friendly(a, b)) {
+                continue;
+            }
+
+            const float delta_x = b.x - a.x;
+            const float delta_y = b.y - a.y;
+            const float radius_sum = a.radius + b.radius;
+
+            if (delta_x * delta_x + delta_y * delta_y <= radius_sum * radius_sum) {
+                m_collisions.push_back({a.entity, b.entity});
+            }
+        }
+    }
+}
+
+void CollisionWorld::prepare_passes() {
+    m_passes.clear();
+
+    const auto bucket = [this](const uint32_t layer) {
+        return std::span<const CollisionProxy>(m_proxies).subspan(
+            m_layer_starts[layer],
+            m_layer_starts[layer + 1] - m_layer_starts[layer]
+        );
+    };
+
+    const float cell_size = SpatialHash::choose_cell_size(m_proxies);
+    for (uint32_t layer = 0; layer < m_layer_count; layer++) {
+        if (m_mode == BroadphaseMode::SpatialHash) {
+            m_grids[layer].rebuild(bucket(layer), m_layer_starts[layer], cell_size);
+        } else {
+            // Sweep and prune has to see empty layers too, or it would hang on to intervals that are long gone.
+            m_sweeps[layer].update(bucket(layer), m_layer_starts[layer]);
+        }
+    }
+
+    for (uint32_t layer = 0; layer < m_layer_count; layer++) {
+        for (uint32_t other = layer; other < m_layer_count; other++) {
+            // This is where layer pairs that can never interact get dropped, bullets against bullets most of all.
+            if (!((m_layer_masks[layer] >> other) & 1u)) {
+                continue;
+            }
+
+            const auto size = static_cast<uint32_t>(bucket(layer).size());
+            const auto other_size = static_cast<uint32_t>(bucket(other).size());
+
+            if (size == 0 || other_size == 0) {
+                continue;
+            }
+
+            if (layer == other) {
+                m_passes.push_back({layer, layer, false, size});
+            } else if (m_mode == BroadphaseMode::SpatialHash) {
+                // Every pair turns up whichever side asks, so ask from the smaller one.
+                if (size <= other_size) {
+                    m_passes.push_back({layer, other, false, size});
+                } else {
+                    m_passes.push_back({other, layer, false, other_size});
+                }
+            } else {
+                m_passes.push_back({layer, other, true, size});
+                m_passes.push_back({other, layer, false, other_size});
+            }
+        }
+    }
+}
+
+void CollisionWorld::detect() {
+    const std::size_t range = total_range();
+
+    std::size_t chunk_count = 1;
+    if (m_thread_pool && m_thread_pool->get_thread_count() > 1) {
+        chunk_count = std::clamp<std::size_t>(
+            range / k_min_chunk_size,
+            1,
+            m_thread_pool->get_thread_count() * k_chunks_per_thread
+        );
+    }
+
+    // Chunks are only ever added, so their buffers keep their capacity from frame to frame.
+    if (m_chunks.size() < chunk_count) {
+        m_chunks.resize(chunk_count);
+    }
+
+    const auto run_chunk = [this, range, chunk_count](const std::size_t index) {
+        auto& chunk = m_chunks[index];
+        chunk.candidates.clear();
+        chunk.hits.clear();
+
+        collect_pairs(range * index / chunk_count, range * (index + 1) / chunk_count, chunk.candidates);
+        drop_friendly_pairs(chunk.candidates);
+        chunk.narrowphase.run(m_proxies, chunk.candidates, chunk.hits);
+    };
+
+    if (chunk_count == 1) {
+        run_chunk(0);
+    } else {
+        m_thread_pool->run(chunk_count, run_chunk);
+    }
+
+    // Chunks cover the range in order, so concatenating them gives exactly what a single thread would have.
+    m_collisions.clear();
+    for (std::size_t index = 0; index < chunk_count; index++) {
+        for (const auto& [first, second] : m_chunks[index].hits) {
+            m_collisions.push_back({m_proxies[first].entity, m_proxies[second].entity});
+        }
+    }
+
+    if (m_verify_parallel && chunk_count > 1) {
+        verify_against_serial();
+    }
+}
+
+bool CollisionWorld::is_friendly(const CollisionProxy& a, const CollisionProxy& b) const {
+    return m_faction_filter
+        && a.faction != CollisionProxy::k_no_faction
+        && b.faction != CollisionProxy::k_no_faction
+        && !m_faction_filter->is_hostile(a.faction, b.faction);
+}
+
+void CollisionWorld::drop_friendly_pairs(std::vector<CollisionPair>& candidates) const {
+    if (!m_faction_filter) {
+        return;
+    }
+
+    std::erase_if(candidates, [this](const CollisionPair& pair) {
+        return is_friendly(m_proxies[pair.first], m_proxies[pair.second]);
+    });
+}
+
+void CollisionWorld::collect_pairs(
+    const std::size_t first,
+    const std::size_t last,
+    std::vector<CollisionPair>& out
+) const {
+    std::size_t offset = 0;
+
+    for (const auto& pass : m_passes) {
+        const std::size_t pass_end = offset + pass.range;
+
+        if (pass_end > first && offset < last) {
+            const auto local_first = static_cast<uint32_t>(std::max(first, offset) - offset);
+            const auto local_last  = static_cast<uint32_t>(std::min(last, pass_end) - offset);
+
+            if (m_mode == BroadphaseMode::SpatialHash) {
+                if (pass.layer == pass.other_layer) {
+                    m_grids[pass.layer].collect_pairs(local_first, local_last, out);
+                } else {
+                    m_grids[pass.layer].collect_pairs_with(m_grids[pass.other_layer], local_first, local_last, out);
+                }
+            } else {
+                if (pass.layer == pass.other_layer) {
+                    m_sweeps[pass.layer].collect_pairs(local_first, local_last, out);
+                } else {
+                    m_sweeps[pass.layer].collect_pairs_with(
+                        m_sweeps[pass.other_layer], local_first, local_last, pass.inclusive, out
+                    );
+                }
+            }
+        }
+
+        offset = pass_end;
+        if (offset >= last) {
+            break;
+        }
+    }
+}
+
+std::size_t CollisionWorld::total_range() const {
+    std::size_t range = 0;
+    for (const auto& pass : m_passes) {
+        range += pass.range;
+    }
+    return range;
+}
+
+void CollisionWorld::verify_against_serial() {
+    m_candidates.clear();
+    m_hits.clear();
+
+    collect_pairs(0, total_range(), m_candidates);
+    drop_friendly_pairs(m_candidates);
+    m_narrowphase.run_scalar(m_proxies, m_candidates, m_hits);
+
+    const auto same = [this](const CollisionPair& hit, const Events::Collision& collision) {
+        return m_proxies[hit.first].entity == collision.a && m_proxies[hit.second].entity == collision.b;
+    };
+    const auto [serial, parallel] = std::ranges::mismatch(m_hits, m_collisions, same);
+    if (serial == m_hits.end() && parallel == m_collisions.end()) {
+        return;
+    }
+
+    m_divergences++;
+
+    // The first pair that differs says far more than the counts do. Either side can be the one that ran out.
+    const auto index = static_cast<std::size_t>(serial - m_hits.begin());
+    std::string serial_pair = "nothing";
+    std::string parallel_pair = "nothing";
+    if (serial != m_hits.end()) {
+        serial_pair = std::format("({}, {})",
+            entt::to_integral(m_proxies[serial->first].entity), entt::to_integral(m_proxies[serial->second].entity));
+    }
+    if (parallel != m_collisions.end()) {
+        parallel_pair = std::format("({}, {})", entt::to_integral(parallel->a), entt::to_integral(parallel->b));
+    }
+
+    H_ERROR("Collision", "Parallel collision pass produced {} hits where the serial pass produced {}. "
+        "Hit {} was {} in parallel and {} serially",
+        m_collisions.size(), m_hits.size(), index, parallel_pair, serial_pair);
+}
@@ -0,0 +1,119 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "AssetManager.hpp"
+#include "CollisionProxy.hpp"
+#include "ContactCache.hpp"
+#include "Enums.hpp"
+#include "Events.hpp"
+#include "Narrowphase.hpp"
+#include "SpatialHash.hpp"
+#include "SweepAndPrune.hpp"
+#include "ThreadPool.hpp"
+
+// Owns the collision state that lives between ticks, so update_collision doesn't rebuild its buffers every frame.
+// Colliders are bucketed by layer, and only layer pairs that can interact are ever handed to the broadphase.
+class CollisionWorld {
+public:
+    // Without a thread pool everything runs on the calling thread.
+    // With verify_parallel set, every split tick is checked against a single threaded run, which is slow but catches divergence.
+    explicit CollisionWorld(
+        BroadphaseMode mode = BroadphaseMode::SpatialHash,
+        ThreadPool* thread_pool = nullptr,
+        bool verify_parallel = false
+    ) : m_mode(mode), m_thread_pool(thread_pool), m_verify_parallel(verify_parallel) {}
+
+    // Needs to be called once the assets are loaded. Until then, nothing collides.
+    void set_layers(const CollisionLayers& layers);
+
+    // With a filter set, pairs of affiliated colliders whose factions aren't hostile are dropped before the narrowphase.
+    // Pass nullptr to report every overlap again.
+    void set_faction_filter(const AssetManager* asset_manager);
+
+    // Gathers every Transform + Collider, runs the broadphase and narrowphase, and updates the contacts from the hits.
+    void update(entt::registry& registry);
+
+    // Every overlap found this tick, whether or not it's new.
+    [[nodiscard]]
+    const std::vector<Events::Collision>& get_collisions() const;
+
+    [[nodiscard]]
+    const ContactCache& get_contacts() const;
+
+    [[nodiscard]]
+    BroadphaseMode get_mode() const;
+
+    // How many verified ticks disagreed with the single threaded run. Always 0 without verify_parallel.
+    [[nodiscard]]
+    uint64_t get_divergences() const;
+
+private:
+    // One layer against itself, or one layer against another.
+    // The range is how many proxies of the first layer get swept or queried.
+    struct Pass {
+        uint32_t layer;
+        uint32_t other_layer;
+        bool inclusive; // Only for sweep and prune between two layers, see SweepAndPrune::collect_pairs_with.
+        uint32_t range;
+    };
+
+    // Scratch space for one slice of the broadphase. Each task only ever touches its own chunk.
+    struct Chunk {
+        std::vector<CollisionPair> candidates;
+        std::vector<CollisionPair> hits;
+        Narrowphase narrowphase;
+    };
+
+    BroadphaseMode m_mode;
+    ThreadPool* m_thread_pool;
+    bool m_verify_parallel;
+    uint64_t m_divergences = 0;
+    const AssetManager* m_faction_filter = nullptr;
+    uint32_t m_layer_count = 0;
+    std::array<uint32_t, CollisionLayers::k_max_layers> m_layer_masks{};
+    std::array<uint32_t, CollisionLayers::k_max_layers + 1> m_layer_starts{};
+    std::vector<CollisionProxy> m_gathered;
+    std::vector<CollisionProxy> m_proxies;
+    std::vector<Pass> m_passes;
+    std::vector<CollisionPair> m_candidates;
+    std::vector<CollisionPair> m_hits;
+    std::vector<Events::Collision> m_collisions;
+    std::vector<Chunk> m_chunks;
+    ContactCache m_contacts;
+    std::array<SpatialHash, CollisionLayers::k_max_layers> m_grids;
+    std::array<SweepAndPrune, CollisionLayers::k_max_layers> m_sweeps;
+    Narrowphase m_narrowphase;
+
+    // Collects proxies and sorts them by layer, keeping registry order within each layer.
+    void gather_proxies(entt::registry& registry);
+
+    // The original every-pair loop, kept around as a reference to benchmark the real broadphases against.
+    void brute_force();
+
+    // Rebuilds the per-layer broadphase structures and lists the layer pairs worth looking at.
+    void prepare_passes();
+
+    // Splits the passes into chunks, runs them on the thread pool, and stitches the hits back together in chunk order.
+    void detect();
+
+    [[nodiscard]]
+    bool is_friendly(const CollisionProxy& a, const CollisionProxy& b) const;
+
+    void drop_friendly_pairs(std::vector<CollisionPair>& candidates) const;
+
+    // Collects candidates for the slice [first, last) of all passes laid end to end.
+    void collect_pairs(std::size_t first, std::size_t last, std::vector<CollisionPair>& out) const;
+
+    [[nodiscard]]
+    std::size_t total_range() const;
+
+    // Redoes the whole tick on one thread and complains if it disagrees with what detect produced.
+    void verify_against_serial();
+};
@@ -3,28 +3,19 @@
 #include "Components.hpp"
 
 #include "AssetManager.hpp"
-#include "Logger.hpp"
 
 using namespace Components;
 
 
 
-Weapon::Weapon(const std::string& key, const AssetManager& asset_manager)
-    : damage(0.0), lifetime(0.0), cooldown(2'000'000) {
-    if (
-        const auto result = asset_manager.get_weapon(key);
-        !result
-    ) {
-        H_WARNING("Weapon Constructor", "Issue constructing weapon '{}', constructing default", key);
-    } else {
-        const auto data = *result;
-        munition = data->munition;
-        damage   = data->damage;
-        lifetime = data->lifetime;
-        cooldown = data->cooldown;
-        radius   = data->radius;
-    }
-}
+Weapon::Weapon(const WeaponPrefab& prefab)
+    : type(prefab.type),
+      munition(prefab.munition),
+      damage(prefab.damage),
+      lifetime(prefab.lifetime),
+      cooldown(prefab.cooldown),
+      radius(prefab.radius),
+      collision_layer(prefab.collision_layer) {}
 
 bool Weapon::can_fire() const {
     return !fire_timer.is_active() || fire_timer.is_done();
@@ -7,17 +7,18 @@
 #include <entt/entt.hpp>
 #include <raylib-cpp.hpp>
 
+#include "AssetId.hpp"
 #include "AssetManager.hpp"
 #include "Timer.hpp"
 
 namespace Components {
 
     struct Affiliation {
-        uint32_t id;
+        FactionId id;
     };
 
     struct Animation {
-        std::vector<std::string> frames;
+        std::vector<TextureId> frames;
         float frame_duration = 1.0f;
         Timer timer;
         size_t current_frame;
@@ -33,8 +34,7 @@ namespace Components {
 
     struct Collider {
         float radius = 0.0f;
-        uint32_t category = 0;
-        uint32_t collides_with = 0;
+        uint32_t layer = CollisionLayers::k_no_layer;
     };
 
     struct DespawnMarker {};
@@ -63,6 +63,12 @@ namespace Components {
 
     struct Player {};
 
+    // Where the entity was at the start of the current tick, so rendering can blend between ticks.
+    struct PreviousTransform {
+        raylib::Vector2 position = {0.0f, 0.0f};
+        float rotation = 0.0f;
+    };
+
     struct PlayerWeapon {};
 
     struct RelativeTransform {
@@ -94,14 +100,17 @@ namespace Components {
 
     struct Weapon {
         Weapon() = default;
-        Weapon(const std::string& key, const AssetManager& asset_manager);
+        explicit Weapon(const WeaponPrefab& prefab);
 
-        std::string munition;
+        // Which weapon this is, for looking its data up again. Invalid for weapons not made from a prefab.
+        WeaponId type;
+        TextureId munition;
         float damage = 0.0f;
         float lifetime = 0.01f;
         float cooldown = 2'000'000.0f;
         float radius = 0.0f;
         float shot_speed = 100;
+        uint32_t collision_layer = CollisionLayers::k_no_layer;
         Timer fire_timer;
 
         bool can_fire() const;
@@ -2,6 +2,7 @@
 
 #include "ConfigManager.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <print>
 
@@ -9,12 +10,40 @@
 
 using json = nlohmann::json;
 
+namespace {
+    BroadphaseMode broadphase_from_string(const std::string_view string) {
+        if (string == "brute_force")     return BroadphaseMode::BruteForce;
+        if (string == "sweep_and_prune") return BroadphaseMode::SweepAndPrune;
+        if (string != "spatial_hash") {
+            std::println("Unknown broadphase '{}', using spatial_hash instead.", string);
+        }
+        return BroadphaseMode::SpatialHash;
+    }
+
+    constexpr float k_default_tick_rate = 60.0f;
+}
+
 ConfigManager::ConfigManager() {
     try {
         std::ifstream file("./META.json");
         json jsonData = json::parse(file);
         title = jsonData.value("title", "Untitled Game");
         log_level = Logger::from_string(jsonData.value("log_level", "Warning"));
+        async_logging = jsonData.value("async_logging", true);
+        log_queue_size = jsonData.value("log_queue_size", Logger::k_default_queue_size);
+        binary_log = jsonData.value("binary_log", "");
+        log_rate_limit = jsonData.value("log_rate_limit", Logger::k_default_rate_limit);
+        broadphase = broadphase_from_string(jsonData.value("broadphase", "spatial_hash"));
+        thread_count = jsonData.value("thread_count", std::size_t{0});
+        verify_collisions = jsonData.value("verify_collisions", false);
+        tick_rate = jsonData.value("tick_rate", k_default_tick_rate);
+        if (tick_rate <= 0.0f) {
+            std::println("tick_rate has to be above zero, using {} instead.", k_default_tick_rate);
+            tick_rate = k_default_tick_rate;
+        }
+        max_ticks_per_frame = std::max(jsonData.value("max_ticks_per_frame", uint32_t{5}), uint32_t{1});
+        max_parked_bullets = jsonData.value("max_parked_bullets", std::size_t{4096});
+        soa_projectiles = jsonData.value("soa_projectiles", false);
     } catch (const std::exception& e) {
         std::println("Error initializing game: {}", e.what());
         throw std::runtime_error("Couldn't initialize game.");
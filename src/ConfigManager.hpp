@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <nlohmann/json.hpp>
 
+#include "Enums.hpp"
 #include "Logger.hpp" // Don't use log() here, as it may be uninitialized and have no output.
 
 struct ConfigManager {
@@ -11,4 +14,15 @@ struct ConfigManager {
 
     std::string title;
     LogLevel log_level;
+    bool async_logging;
+    std::size_t log_queue_size;
+    std::string binary_log;
+    uint32_t log_rate_limit;
+    BroadphaseMode broadphase;
+    std::size_t thread_count;
+    bool verify_collisions;
+    float tick_rate;
+    uint32_t max_ticks_per_frame;
+    std::size_t max_parked_bullets;
+    bool soa_projectiles;
 };
@@ -0,0 +1,61 @@
+// Copyright 2025 RestingImmortal
+
+#include "ContactCache.hpp"
+
+#include <algorithm>
+
+// Public Methods
+
+void ContactCache::update(const std::span<const Events::Collision> collisions) {
+    m_current.clear();
+    for (const auto& collision : collisions) {
+        m_current.push_back({key_of(collision), collision});
+    }
+    std::ranges::sort(m_current, {}, &Contact::key);
+
+    const auto duplicates = std::ranges::unique(m_current, {}, &Contact::key);
+    m_current.erase(duplicates.begin(), duplicates.end());
+
+    m_began.clear();
+    m_persisted.clear();
+    m_ended.clear();
+
+    // Both lists are sorted by key, so one merge walk sorts every contact into its bucket.
+    auto previous = m_previous.begin();
+    auto current = m_current.begin();
+    while (previous != m_previous.end() || current != m_current.end()) {
+        if (current == m_current.end() || (previous != m_previous.end() && previous->key < current->key)) {
+            m_ended.push_back(previous->pair);
+            ++previous;
+        } else if (previous == m_previous.end() || current->key < previous->key) {
+            m_began.push_back(current->pair);
+            ++current;
+        } else {
+            m_persisted.push_back(current->pair);
+            ++previous;
+            ++current;
+        }
+    }
+
+    std::swap(m_previous, m_current);
+}
+
+const std::vector<Events::Collision>& ContactCache::get_began() const {
+    return m_began;
+}
+
+const std::vector<Events::Collision>& ContactCache::get_persisted() const {
+    return m_persisted;
+}
+
+const std::vector<Events::Collision>& ContactCache::get_ended() const {
+    return m_ended;
+}
+
+// Private Methods
+
+uint64_t ContactCache::key_of(const Events::Collision& collision) {
+    const auto a = static_cast<uint64_t>(entt::to_integral(collision.a));
+    const auto b = static_cast<uint64_t>(entt::to_integral(collision.b));
+    return (std::min(a, b) << 32) | std::max(a, b);
+}
@@ -0,0 +1,42 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Events.hpp"
+
+// Remembers which pairs were touching last tick, so a contact can be reported as beginning, persisting, or ending
+// instead of as a fresh collision every frame it lasts.
+class ContactCache {
+public:
+    // Diffs this tick's overlaps against last tick's.
+    void update(std::span<const Events::Collision> collisions);
+
+    // All three are sorted by pair, so their order doesn't depend on how the overlaps were found.
+    [[nodiscard]]
+    const std::vector<Events::Collision>& get_began() const;
+
+    [[nodiscard]]
+    const std::vector<Events::Collision>& get_persisted() const;
+
+    [[nodiscard]]
+    const std::vector<Events::Collision>& get_ended() const;
+
+private:
+    struct Contact {
+        uint64_t key;
+        Events::Collision pair;
+    };
+
+    std::vector<Contact> m_previous;
+    std::vector<Contact> m_current;
+    std::vector<Events::Collision> m_began;
+    std::vector<Events::Collision> m_persisted;
+    std::vector<Events::Collision> m_ended;
+
+    // The same key for a pair whichever way round it was reported.
+    static uint64_t key_of(const Events::Collision& collision);
+};
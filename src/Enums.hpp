@@ -1,5 +1,11 @@
 #pragma once
 
+enum class BroadphaseMode {
+    BruteForce,
+    SpatialHash,
+    SweepAndPrune,
+};
+
 enum class HitQuadrant {
     Front,
     Right,
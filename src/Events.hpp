@@ -3,8 +3,27 @@
 #include <entt/entt.hpp>
 
 namespace Events {
+    // A single tick's overlap, as found by the CollisionWorld. Not dispatched on its own.
     struct Collision {
         entt::entity a;
         entt::entity b;
     };
+
+    // Two colliders started overlapping this tick.
+    struct CollisionBegin {
+        entt::entity a;
+        entt::entity b;
+    };
+
+    // Two colliders that were already overlapping still are.
+    struct CollisionPersist {
+        entt::entity a;
+        entt::entity b;
+    };
+
+    // Two colliders stopped overlapping. Either one may have been destroyed since, so check before using them.
+    struct CollisionEnd {
+        entt::entity a;
+        entt::entity b;
+    };
 }
@@ -0,0 +1,55 @@
+// Copyright 2025 RestingImmortal
+
+#include "FrameArena.hpp"
+
+#include <bit>
+
+#include "Logger.hpp"
+
+// Public Methods
+
+FrameArena::FrameArena(const std::size_t capacity) :
+    m_capacity(capacity),
+    m_buffer(std::make_unique<std::byte[]>(capacity)) {
+    m_resource.emplace(m_buffer.get(), m_capacity, &m_overflow);
+}
+
+void FrameArena::reset() {
+    m_resource->release();
+
+    if (m_overflow.spilled == 0) {
+        return;
+    }
+
+    // Built fresh around a bigger buffer, as a monotonic resource can't be handed a new one.
+    m_capacity = std::bit_ceil(m_capacity + m_overflow.spilled);
+    m_overflow.spilled = 0;
+    m_resource.reset();
+    m_buffer = std::make_unique<std::byte[]>(m_capacity);
+    m_resource.emplace(m_buffer.get(), m_capacity, &m_overflow);
+
+    H_DEBUG("Frame Arena", "Grew to {} bytes", m_capacity);
+}
+
+std::pmr::memory_resource& FrameArena::get_resource() {
+    return *m_resource;
+}
+
+std::size_t FrameArena::get_capacity() const {
+    return m_capacity;
+}
+
+// Private Methods
+
+void* FrameArena::OverflowResource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+    spilled += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void FrameArena::OverflowResource::do_deallocate(void* pointer, const std::size_t bytes, const std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+}
+
+bool FrameArena::OverflowResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,50 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+// Scratch memory that only has to last one frame. Allocating is a pointer bump, freeing does nothing,
+// and reset hands the whole buffer back at once. Meant for std::pmr containers that systems build and throw away.
+class FrameArena {
+public:
+    static constexpr std::size_t k_default_capacity = 1 << 20;
+
+    explicit FrameArena(std::size_t capacity = k_default_capacity);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Everything handed out since the last reset is gone after this, so nothing may still be holding onto it.
+    // If the last frame outgrew the buffer, the buffer grows to fit so it won't spill again.
+    void reset();
+
+    [[nodiscard]]
+    std::pmr::memory_resource& get_resource();
+
+    [[nodiscard]]
+    std::size_t get_capacity() const;
+
+private:
+    // Sits behind the buffer and notes how much spilled past it.
+    class OverflowResource final : public std::pmr::memory_resource {
+    public:
+        std::size_t spilled = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+
+        [[nodiscard]]
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    std::size_t m_capacity;
+    std::unique_ptr<std::byte[]> m_buffer;
+    OverflowResource m_overflow;
+    std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+};
@@ -1,29 +1,49 @@
 #include "Functions.hpp"
 
+#include <cmath>
+
 HitQuadrant calculate_direction(const Components::Transform& a, const Components::Transform& b) {
     const raylib::Vector2 delta = b.position - a.position;
-    const float angle_rad = std::atan2(delta.y, delta.x);
-    const float angle_deg = angle_rad * RAD2DEG;
+    const float rotation_rad = a.rotation * DEG2RAD;
 
-    float relative_angle = angle_deg - a.rotation - 270;
+    return classify_hit(delta.x, delta.y, std::sin(rotation_rad), -std::cos(rotation_rad));
+}
 
-    relative_angle = std::fmod(relative_angle, 360.0f);
-    if (relative_angle < 0) {
-        relative_angle += 360.0f;
-    }
+Components::Transform interpolate_transform(
+    const Components::Transform& current,
+    const Components::PreviousTransform& previous,
+    const float alpha
+) {
+    const float rotation_delta = std::remainder(current.rotation - previous.rotation, 360.0f);
 
-    if (relative_angle <= 45 || relative_angle >= 315) {
-        return HitQuadrant::Front;
-    }
-    if (relative_angle >= 45 && relative_angle <= 135) {
-        return HitQuadrant::Right;
-    }
-    if (relative_angle >= 135 && relative_angle <= 225) {
-        return HitQuadrant::Back;
-    }
-    if (relative_angle >= 225 && relative_angle <= 315) {
-        return HitQuadrant::Left;
-    }
+    return {
+        previous.position + (current.position - previous.position) * alpha,
+        current.size,
+        previous.rotation + rotation_delta * alpha
+    };
+}
+
+HitQuadrant classify_hit(const float offset_x, const float offset_y, const float forward_x, const float forward_y) {
+    // Right is forward turned a quarter clockwise, so this is the cross product of forward and offset.
+    const float ahead = offset_x * forward_x + offset_y * forward_y;
+    const float beside = forward_x * offset_y - forward_y * offset_x;
 
-    return HitQuadrant::Back;
+    // The quadrants are split along the diagonals, which is where both projections are the same length.
+    // Written as selects rather than early returns so the batched loop doesn't branch.
+    const float side = std::abs(beside);
+    const HitQuadrant sideways = beside > 0.0f ? HitQuadrant::Right : HitQuadrant::Left;
+    const HitQuadrant behind_or_sideways = -ahead >= side ? HitQuadrant::Back : sideways;
+    return ahead >= side ? HitQuadrant::Front : behind_or_sideways;
+}
+
+void classify_hits(
+    const std::span<const float> offset_x,
+    const std::span<const float> offset_y,
+    const std::span<const float> forward_x,
+    const std::span<const float> forward_y,
+    const std::span<HitQuadrant> out
+) {
+    for (std::size_t i = 0; i < out.size(); i++) {
+        out[i] = classify_hit(offset_x[i], offset_y[i], forward_x[i], forward_y[i]);
+    }
 }
@@ -1,6 +1,28 @@
 #pragma once
 
+#include <span>
+
 #include "Enums.hpp"
 #include "Components.hpp"
 
 HitQuadrant calculate_direction(const Components::Transform& a, const Components::Transform& b);
+
+// Blends from previous to current by alpha in [0, 1]. Rotation takes the short way around.
+Components::Transform interpolate_transform(
+    const Components::Transform& current,
+    const Components::PreviousTransform& previous,
+    float alpha
+);
+
+// Which side of a ship facing (forward_x, forward_y) was hit by something offset (offset_x, offset_y) from it.
+// forward has to be a unit vector, offset can be any length.
+HitQuadrant classify_hit(float offset_x, float offset_y, float forward_x, float forward_y);
+
+// classify_hit over whole arrays at once. All spans have to be the same length.
+void classify_hits(
+    std::span<const float> offset_x,
+    std::span<const float> offset_y,
+    std::span<const float> forward_x,
+    std::span<const float> forward_y,
+    std::span<HitQuadrant> out
+);
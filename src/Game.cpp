@@ -2,7 +2,14 @@
 
 #include "Game.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <print>
+
 #include "Components.hpp"
+#include "Logger.hpp"
+#include "SimClock.hpp"
 #include "Systems.hpp"
 #include "raylib.h"
 
@@ -11,19 +18,76 @@
 void Game::run() {
     init();
 
-    while (!m_window.ShouldClose()) {
-        const float dt = m_window.GetFrameTime();
-        update(dt);
-        render();
+    SetTargetFPS(60);
+    float accumulator = 0.0f;
+
+    while (!m_window->ShouldClose()) {
+        m_frame_arena.reset();
+        accumulator += m_window->GetFrameTime();
+
+        // If ticks take longer than they simulate, catching up only makes the next frame later.
+        // Past the cap the simulation just runs slower than real time instead of locking up.
+        accumulator = std::min(accumulator, m_tick_duration * static_cast<float>(m_max_ticks_per_frame));
+
+        while (accumulator >= m_tick_duration) {
+            update(m_tick_duration);
+            accumulator -= m_tick_duration;
+        }
+
+        handle_debug_keys();
+        m_profiler.measure("render", [&] { render(accumulator / m_tick_duration); });
+    }
+}
+
+void Game::run_headless(const uint64_t tick_count) {
+    init();
+    m_profiler.reset();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t tick = 0; tick < tick_count; tick++) {
+        m_frame_arena.reset();
+        update(m_tick_duration);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::println(
+        "{} ticks in {:.3f}s, {:.1f} ticks per second ({:.1f}x real time)",
+        tick_count,
+        elapsed.count(),
+        static_cast<double>(tick_count) / elapsed.count(),
+        static_cast<double>(tick_count) * m_tick_duration / elapsed.count()
+    );
+    m_profiler.print_report();
+
+    const auto& pool = m_bullet_pool.get_stats();
+    std::println(
+        "Bullet pool: {} reused, {} created, {} destroyed while full, {} parked (peak {})",
+        pool.hits, pool.misses, pool.destroyed, pool.parked, pool.high_water
+    );
+
+    // Anything that hit the rate limit is worth a look, as it was logging every tick.
+    for (const auto& site : Logger::get().get_site_stats()) {
+        if (site.suppressed > 0) {
+            std::println(
+                "Noisy log line at {}:{}: logged {} times, {} suppressed: \"{}\"",
+                site.file, site.line, site.logged, site.suppressed, site.format
+            );
+        }
     }
 }
 
 // Private Methods
 
 void Game::init() {
-    SetTargetFPS(60);
+    // Timers started while loading count from here.
+    SimClock::reset();
 
-    m_asset_manager.load_assets();
+    // Without a window there's no GL context to upload textures to.
+    m_asset_manager.load_assets(m_window.has_value(), &m_thread_pool);
+    m_collision_world.set_layers(m_asset_manager.get_collision_layers());
+    m_projectiles.set_layers(m_asset_manager.get_collision_layers());
+    // Collisions are only used for combat for now, so friendly pairs can go before they cost anything.
+    m_collision_world.set_faction_filter(&m_asset_manager);
 
     setup_event_handlers();
 
@@ -35,33 +99,64 @@ void Game::init() {
 }
 
 void Game::update(const float dt) {
-    update_weapon_timers(m_registry, dt);
-    update_bullet_timers(m_registry, dt);
-    player_movement(m_registry, m_asset_manager, dt);
-    update_physics_transforms(m_registry, dt);
-    update_local_transforms(m_registry);
-    update_collision(m_registry, m_dispatcher);
-    update_background_position(m_registry);
-    engine_visibility(m_registry);
-    mark_bullets_for_despawn(m_registry);
-    camera_to_player(m_registry, m_camera);
-    despawn_entities(m_registry);
-
-    m_dispatcher.update();
+    m_profiler.measure("store_previous_transforms", [&] { store_previous_transforms(m_registry, m_frame_arena.get_resource()); });
+    // Every Timer reads this, so moving it along is all it takes to run them.
+    SimClock::advance(dt);
+    m_profiler.measure("player_movement", [&] { player_movement(
+        m_registry, m_asset_manager, m_bullet_pool, m_use_projectile_manager ? &m_projectiles : nullptr, dt
+    ); });
+    m_profiler.measure("update_physics_transforms", [&] { update_physics_transforms(m_registry, dt); });
+    m_profiler.measure("update_projectiles", [&] { m_projectiles.update(dt); });
+    m_profiler.measure("update_local_transforms", [&] { update_local_transforms(m_registry); });
+    m_profiler.measure("update_collision", [&] { update_collision(m_registry, m_dispatcher, m_collision_world); });
+    m_profiler.measure("collide_projectiles", [&] { m_projectiles.collide(m_registry, m_asset_manager, m_collision_resolver); });
+    m_profiler.measure("update_background_position", [&] { update_background_position(m_registry); });
+    m_profiler.measure("engine_visibility", [&] { engine_visibility(m_registry); });
+    m_profiler.measure("mark_bullets_for_despawn", [&] { mark_bullets_for_despawn(m_registry, m_bullet_pool); });
+    m_profiler.measure("despawn_entities", [&] { despawn_entities(m_registry, m_frame_arena.get_resource()); });
+
+    m_profiler.measure("dispatch_events", [&] { m_dispatcher.update(); });
+    m_profiler.measure("resolve_collisions", [&] { resolve_collisions(m_registry, m_asset_manager, m_collision_resolver, m_bullet_pool); });
 }
 
-void Game::render() {
-    m_window.BeginDrawing();
-        m_window.ClearBackground(raylib::Color::Black());
+void Game::render(const float alpha) {
+    camera_to_player(m_registry, m_camera, alpha);
+
+    m_window->BeginDrawing();
+        m_window->ClearBackground(raylib::Color::Black());
 
         m_camera.BeginMode();
-            render_sprites(m_registry);
+            render_sprites(m_registry, alpha, m_frame_arena.get_resource());
+            // Bullets draw over everything else, so projectiles do too.
+            m_projectiles.render(alpha, m_frame_arena.get_resource());
         m_camera.EndMode();
 
-    m_window.EndDrawing();
+        if (m_show_profiler) {
+            render_profiler_overlay(m_profiler);
+        }
+
+    m_window->EndDrawing();
 }
 
 void Game::setup_event_handlers() {
-    m_dispatcher.sink<Events::Collision>().connect<&Game::handle_collision>(this);
+    m_dispatcher.sink<Events::CollisionBegin>().connect<&CollisionResolver::push>(m_collision_resolver);
 }
 
+void Game::handle_debug_keys() {
+    if (IsKeyPressed(KEY_F3)) {
+        m_show_profiler = !m_show_profiler;
+    }
+
+    if (IsKeyPressed(KEY_F4)) {
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        const std::string path = std::format("trace_{}.json", seconds);
+
+        if (m_profiler.write_trace(path)) {
+            H_INFO("Profiler", "Wrote trace to {}", path);
+        } else {
+            H_ERROR("Profiler", "Couldn't write trace to {}", path);
+        }
+    }
+}
@@ -2,45 +2,84 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
+
 #include <entt/entt.hpp>
 #include <raylib-cpp.hpp>
 
 #include "AssetManager.hpp"
+#include "BulletPool.hpp"
+#include "CollisionResolver.hpp"
+#include "CollisionWorld.hpp"
+#include "ConfigManager.hpp"
 #include "Events.hpp"
+#include "FrameArena.hpp"
+#include "Profiler.hpp"
+#include "ProjectileManager.hpp"
 #include "Systems.hpp"
+#include "ThreadPool.hpp"
 
 class Game {
 public:
-    Game(const int width, const int height, const std::string& title) :
-        m_window(width, height, title),
+    Game(const int width, const int height, const ConfigManager& configs) :
+        Game(width, height, configs, false) {}
+
+    // Runs without a window, a GL context, or any textures. Only run_headless works on a game made this way.
+    explicit Game(const ConfigManager& configs) :
+        Game(0, 0, configs, true) {}
+
+    void run();
+
+    // Runs tick_count ticks back to back as fast as possible, then prints how long they took.
+    void run_headless(uint64_t tick_count);
+
+private:
+    Game(const int width, const int height, const ConfigManager& configs, const bool headless) :
+        m_window(headless ? std::nullopt : std::optional<raylib::Window>(std::in_place, width, height, configs.title)),
         m_camera(
             {GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f},
             {0, 0},
             0.0f,
             1.0f
-        ) {
-            m_window.SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+        ),
+        m_tick_duration(1.0f / configs.tick_rate),
+        m_max_ticks_per_frame(configs.max_ticks_per_frame),
+        m_thread_pool(configs.thread_count),
+        m_collision_world(configs.broadphase, &m_thread_pool, configs.verify_collisions),
+        m_bullet_pool(configs.max_parked_bullets),
+        m_use_projectile_manager(configs.soa_projectiles) {
+            if (m_window) {
+                m_window->SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+            }
         }
 
-    void run();
-
-private:
     entt::registry m_registry;
     entt::dispatcher m_dispatcher;
-    raylib::Window m_window;
+    std::optional<raylib::Window> m_window;
     raylib::Camera2D m_camera;
     AssetManager m_asset_manager;
+    float m_tick_duration;
+    uint32_t m_max_ticks_per_frame;
+    ThreadPool m_thread_pool;
+    CollisionWorld m_collision_world;
+    CollisionResolver m_collision_resolver;
+    BulletPool m_bullet_pool;
+    ProjectileManager m_projectiles;
+    bool m_use_projectile_manager;
+    Profiler m_profiler;
+    FrameArena m_frame_arena;
+    bool m_show_profiler = false;
 
     void init();
 
     void update(float dt);
 
-    void render();
+    // alpha is how far the current frame is between the last two ticks.
+    void render(float alpha);
 
     void setup_event_handlers();
 
-    void handle_collision(const Events::Collision& event) {
-        on_collision(m_registry, m_asset_manager, event);
-
-    }
+    // F3 toggles the profiler overlay, F4 writes out a trace of the last few thousand sections.
+    void handle_debug_keys();
 };
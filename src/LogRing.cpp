@@ -0,0 +1,33 @@
+// Copyright 2025 RestingImmortal
+
+#include "LogRing.hpp"
+
+#include <algorithm>
+#include <bit>
+
+// Public Methods
+
+LogRing::LogRing(const std::size_t capacity)
+    : m_slots(std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))),
+      m_mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1) {
+    for (std::size_t i = 0; i <= m_mask; i++) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+void LogRing::wait(const uint32_t seen) const {
+    m_published.wait(seen, std::memory_order_acquire);
+}
+
+void LogRing::wake() {
+    m_published.fetch_add(1, std::memory_order_release);
+    m_published.notify_all();
+}
+
+uint32_t LogRing::get_published() const {
+    return m_published.load(std::memory_order_acquire);
+}
+
+uint64_t LogRing::get_dropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
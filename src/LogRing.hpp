@@ -0,0 +1,108 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+// Bounded queue of log lines. Any number of threads can push without taking a lock, and one thread reads them back
+// out in the order they were claimed. Pushing never waits: when every slot is taken the line is dropped and counted.
+//
+// Slots are fixed size and written in place, so nothing is allocated once the ring exists.
+class LogRing {
+public:
+    // Lines longer than this are cut short, with the end marked by "...".
+    static constexpr std::size_t k_max_line = 240;
+
+    // Capacity is rounded up to a power of two.
+    explicit LogRing(std::size_t capacity);
+
+    // write(char* text, std::size_t capacity) fills in a line and returns its length, which may be more than capacity
+    // if it had to be cut short. Returns false if the ring was full.
+    template <typename Write>
+    bool try_push(Write&& write) {
+        std::size_t position = m_head.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        while (true) {
+            slot = &m_slots[position & m_mask];
+            const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (difference == 0) {
+                if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // The reader hasn't got to this slot from the last time around yet.
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        const std::size_t length = write(slot->text, k_max_line);
+        if (length > k_max_line) {
+            slot->text[k_max_line - 3] = '.';
+            slot->text[k_max_line - 2] = '.';
+            slot->text[k_max_line - 1] = '.';
+        }
+        slot->length = static_cast<uint32_t>(length < k_max_line ? length : k_max_line);
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        m_published.fetch_add(1, std::memory_order_release);
+        m_published.notify_one();
+        return true;
+    }
+
+    // Hands every line that's ready to read(std::string_view), oldest first, and returns how many there were.
+    // Only one thread may drain at a time.
+    template <typename Read>
+    std::size_t drain(Read&& read) {
+        std::size_t count = 0;
+
+        while (true) {
+            Slot& slot = m_slots[m_tail & m_mask];
+            if (slot.sequence.load(std::memory_order_acquire) != m_tail + 1) {
+                return count;
+            }
+
+            read(std::string_view(slot.text, slot.length));
+
+            slot.sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+            m_tail++;
+            count++;
+        }
+    }
+
+    // Blocks until something is pushed after get_published returned seen, or wake is called.
+    void wait(uint32_t seen) const;
+
+    void wake();
+
+    [[nodiscard]]
+    uint32_t get_published() const;
+
+    [[nodiscard]]
+    uint64_t get_dropped() const;
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        uint32_t length;
+        char text[k_max_line];
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask;
+
+    // Writers and the reader each get their own cache line, so they don't slow each other down.
+    alignas(64) std::atomic<std::size_t> m_head = 0;
+    alignas(64) std::size_t m_tail = 0;
+    alignas(64) std::atomic<uint32_t> m_published = 0;
+    std::atomic<uint64_t> m_dropped = 0;
+};
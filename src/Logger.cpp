@@ -0,0 +1,197 @@
+// Copyright 2025 RestingImmortal
+
+#include "Logger.hpp"
+
+#include <chrono>
+
+// Public Methods
+
+void Logger::start_async(const std::size_t queue_size) {
+    if (m_ring.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    m_ring_storage = std::make_unique<LogRing>(queue_size);
+    m_reported_dropped = 0;
+    m_stopping.store(false, std::memory_order_relaxed);
+    m_writer = std::thread([this] { write_async(); });
+
+    m_ring.store(m_ring_storage.get(), std::memory_order_release);
+}
+
+void Logger::stop_async() {
+    if (!m_ring.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    m_ring.store(nullptr, std::memory_order_release);
+    m_stopping.store(true, std::memory_order_release);
+    m_ring_storage->wake();
+    m_writer.join();
+
+    m_ring_storage.reset();
+}
+
+uint64_t Logger::get_dropped() const {
+    const LogRing* ring = m_ring.load(std::memory_order_acquire);
+    return ring ? ring->get_dropped() : 0;
+}
+
+bool Logger::start_binary(const std::filesystem::path& path) {
+    if (m_binary.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    auto binary = std::make_unique<BinaryLog>(path);
+    if (!binary->is_open()) {
+        return false;
+    }
+
+    // Sites that logged before now still need describing, or the decoder can't make sense of them.
+    std::scoped_lock lock(m_sites_mutex);
+    for (uint32_t id = 0; id < m_sites.size(); id++) {
+        write_site(*binary, id, *m_sites[id]);
+    }
+
+    m_binary_storage = std::move(binary);
+    m_binary.store(m_binary_storage.get(), std::memory_order_release);
+    return true;
+}
+
+void Logger::stop_binary() {
+    m_binary.store(nullptr, std::memory_order_release);
+    m_binary_storage.reset();
+}
+
+std::vector<LogSiteStats> Logger::get_site_stats() {
+    std::scoped_lock lock(m_sites_mutex);
+
+    std::vector<LogSiteStats> stats;
+    stats.reserve(m_sites.size());
+    for (const LogSite* site : m_sites) {
+        stats.push_back({
+            .level = site->level,
+            .context = site->context,
+            .format = site->format,
+            .file = site->file,
+            .line = site->line,
+            .logged = site->logged.load(std::memory_order_relaxed),
+            .suppressed = site->suppressed.load(std::memory_order_relaxed)
+        });
+    }
+    return stats;
+}
+
+// Private Methods
+
+Logger::~Logger() {
+    // Sites that went quiet while being limited haven't said what they held back yet.
+    {
+        std::scoped_lock lock(m_sites_mutex);
+        for (LogSite* site : m_sites) {
+            report_suppressed(*site);
+        }
+    }
+
+    stop_binary();
+    stop_async();
+}
+
+uint32_t Logger::register_site(LogSite& site) {
+    std::scoped_lock lock(m_sites_mutex);
+
+    // Another thread may have got here first.
+    if (const uint32_t id = site.id.load(std::memory_order_relaxed); id != LogSite::k_unregistered) {
+        return id;
+    }
+
+    const auto id = static_cast<uint32_t>(m_sites.size());
+    m_sites.push_back(&site);
+
+    // Described before the id is published, so the description always comes first in the file.
+    if (BinaryLog* binary = m_binary.load(std::memory_order_acquire)) {
+        write_site(*binary, id, site);
+    }
+
+    site.id.store(id, std::memory_order_release);
+    return id;
+}
+
+void Logger::write_site(BinaryLog& binary, const uint32_t id, const LogSite& site) {
+    binary.write_site(id, static_cast<uint8_t>(site.level), site.context, site.format, site.file, site.line);
+}
+
+bool Logger::admit(LogSite& site) {
+    const uint32_t limit = s_rate_limit.load(std::memory_order_relaxed);
+    // Critical lines are rare, and too important to lose.
+    if (limit == 0 || site.level >= LogLevel::Critical) {
+        return true;
+    }
+
+    constexpr int64_t window_length = std::chrono::nanoseconds(std::chrono::seconds(1)).count();
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+
+    // Only one thread gets to start the new window. Lines racing it may land in either one, which is close enough.
+    if (
+        int64_t start = site.window_start.load(std::memory_order_relaxed);
+        now - start >= window_length &&
+        site.window_start.compare_exchange_strong(start, now, std::memory_order_relaxed)
+    ) {
+        site.window_lines.store(0, std::memory_order_relaxed);
+        report_suppressed(site);
+    }
+
+    if (site.window_lines.fetch_add(1, std::memory_order_relaxed) < limit) {
+        return true;
+    }
+
+    site.window_suppressed.fetch_add(1, std::memory_order_relaxed);
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Logger::report_suppressed(LogSite& site) {
+    if (const uint32_t count = site.window_suppressed.exchange(0, std::memory_order_relaxed); count > 0) {
+        log_format(site.level, site.context, "Suppressed {} more lines like \"{}\"", count, site.format);
+    }
+}
+
+void Logger::write_async() {
+    while (true) {
+        const uint32_t seen = m_ring_storage->get_published();
+        flush_ring();
+
+        // Whatever was pushed before stopping is written by the flush above, since stopping wakes this up first.
+        if (m_stopping.load(std::memory_order_acquire)) {
+            flush_ring();
+            return;
+        }
+
+        m_ring_storage->wait(seen);
+    }
+}
+
+void Logger::flush_ring() {
+    std::scoped_lock lock(m_mutex);
+
+    m_ring_storage->drain([this](const std::string_view line) {
+        for (auto& sink : m_sinks) {
+            sink->write(line);
+        }
+    });
+
+    if (
+        const uint64_t dropped = m_ring_storage->get_dropped();
+        dropped != m_reported_dropped
+    ) {
+        const auto note = std::format(
+            "[{}] [Logger] Dropped {} lines as the log queue was full", to_string(LogLevel::Warning), dropped - m_reported_dropped
+        );
+        for (auto& sink : m_sinks) {
+            sink->write(note);
+        }
+        m_reported_dropped = dropped;
+    }
+}
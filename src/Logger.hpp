@@ -2,14 +2,23 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <format>
 #include <memory>
 #include <mutex>
 #include <print>
 #include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "BinaryLog.hpp"
+#include "LogRing.hpp"
+
 enum class LogLevel {
     Trace,
     Debug,
@@ -20,6 +29,39 @@ enum class LogLevel {
     Off
 };
 
+// Where a line is logged from. H_LOG gives every call site its own, filled in at compile time.
+// The id is handed out the first time the site logs anything.
+struct LogSite {
+    static constexpr uint32_t k_unregistered = UINT32_MAX;
+
+    LogLevel level;
+    std::string_view context;
+    std::string_view format;
+    std::string_view file;
+    uint32_t line;
+    std::atomic<uint32_t> id = k_unregistered;
+
+    // Totals since startup.
+    std::atomic<uint64_t> logged = 0;
+    std::atomic<uint64_t> suppressed = 0;
+
+    // The current rate limiting window, and what happened in it so far.
+    std::atomic<int64_t> window_start = 0;
+    std::atomic<uint32_t> window_lines = 0;
+    std::atomic<uint32_t> window_suppressed = 0;
+};
+
+// A snapshot of one call site, from Logger::get_site_stats.
+struct LogSiteStats {
+    LogLevel level;
+    std::string_view context;
+    std::string_view format;
+    std::string_view file;
+    uint32_t line;
+    uint64_t logged;
+    uint64_t suppressed;
+};
+
 // Interface for log sinks. Because we might have multiple kinds of em later.
 struct ILogSink {
     virtual ~ILogSink() = default;
@@ -50,6 +92,11 @@ public:
         s_level.store(level, std::memory_order_relaxed);
     }
 
+    // How many lines each call site may log per second before the rest are counted instead. 0 means no limit.
+    static void set_rate_limit(const uint32_t lines_per_second) noexcept {
+        s_rate_limit.store(lines_per_second, std::memory_order_relaxed);
+    }
+
     // Make the log push to a specific sink
     void add_sink(std::unique_ptr<ILogSink> sink) {
         m_sinks.push_back(std::move(sink));
@@ -79,11 +126,50 @@ public:
 
     // Does all the logging. Should be called through the appropriate macro.
     void log(const LogLevel level, std::string_view context, std::string_view message) {
-        // Ignore low log levels
+        log_format(level, context, "{}", message);
+    }
+
+    // What the macros call. With a binary log open, lines go there as raw arguments, and only warnings and up
+    // are also formatted for the sinks.
+    // A site logging faster than the rate limit has the extra lines left out of the sinks, and says how many it left
+    // out once the next second starts. The binary log is cheap enough to keep all of them.
+    template <typename... Args>
+    void log_site(LogSite& site, std::format_string<Args...> fmt, Args&&... args) {
+        const uint32_t id = get_site_id(site);
+        site.logged.fetch_add(1, std::memory_order_relaxed);
+
+        if (BinaryLog* binary = m_binary.load(std::memory_order_acquire)) {
+            binary->write_line(id, args...);
+            if (site.level < LogLevel::Warning) {
+                return;
+            }
+        }
+
+        if (!admit(site)) {
+            return;
+        }
+
+        log_format(site.level, site.context, fmt, std::forward<Args>(args)...);
+    }
+
+    // In async mode the line is formatted straight into the queue, without allocating.
+    // Critical lines skip the queue, as they tend to come right before the game goes down.
+    template <typename... Args>
+    void log_format(const LogLevel level, const std::string_view context, std::format_string<Args...> fmt, Args&&... args) {
+        if (LogRing* ring = m_ring.load(std::memory_order_acquire); ring && level < LogLevel::Critical) {
+            ring->try_push([&](char* text, const std::size_t capacity) {
+                const auto prefix = std::format_to_n(text, capacity, "[{}] [{}] ", to_string(level), context);
+                const std::size_t prefix_length = std::min<std::size_t>(prefix.size, capacity);
 
-        auto level_string = to_string(level);
+                const auto message = std::format_to_n(
+                    text + prefix_length, capacity - prefix_length, fmt, std::forward<Args>(args)...
+                );
+                return prefix.size + message.size;
+            });
+            return;
+        }
 
-        auto formatted = std::format("[{}] [{}] {}", level_string, context, message);
+        auto formatted = std::format("[{}] [{}] {}", to_string(level), context, std::format(fmt, std::forward<Args>(args)...));
 
         std::scoped_lock lock(m_mutex);
 
@@ -92,19 +178,81 @@ public:
         }
     }
 
+    // From here on, logging only queues lines, and a background thread hands them to the sinks. Lines logged while the
+    // queue is full are dropped rather than held up for, so logging never stalls a frame.
+    // Sinks should all be added before this.
+    void start_async(std::size_t queue_size = k_default_queue_size);
+
+    // Writes out everything still queued and goes back to logging directly. Nothing else may be logging meanwhile.
+    void stop_async();
+
+    // Lines dropped because the queue was full, since async logging started.
+    [[nodiscard]]
+    uint64_t get_dropped() const;
+
+    // Sends every line to a binary log at path as well, for horizons_logdecode to read back later.
+    // Returns false if the file couldn't be opened.
+    bool start_binary(const std::filesystem::path& path);
+
+    // Closes the binary log. Like stop_async, nothing else may be logging meanwhile.
+    void stop_binary();
+
+    // Every call site that has logged so far, in the order they first did.
+    [[nodiscard]]
+    std::vector<LogSiteStats> get_site_stats();
+
+    static constexpr std::size_t k_default_queue_size = 4096;
+    static constexpr uint32_t k_default_rate_limit = 20;
+
 private:
     Logger() = default;
 
+    ~Logger();
+
     inline static std::atomic<LogLevel> s_level{LogLevel::Info}; // Memory black magic, to go along with our macro magic.
+    inline static std::atomic<uint32_t> s_rate_limit{k_default_rate_limit};
     std::vector<std::unique_ptr<ILogSink>> m_sinks;
     std::mutex m_mutex;
+
+    std::unique_ptr<LogRing> m_ring_storage;
+    std::atomic<LogRing*> m_ring = nullptr;
+    std::thread m_writer;
+    std::atomic<bool> m_stopping = false;
+    uint64_t m_reported_dropped = 0;
+
+    std::unique_ptr<BinaryLog> m_binary_storage;
+    std::atomic<BinaryLog*> m_binary = nullptr;
+    std::mutex m_sites_mutex;
+    std::vector<LogSite*> m_sites;
+
+    [[nodiscard]]
+    uint32_t get_site_id(LogSite& site) {
+        const uint32_t id = site.id.load(std::memory_order_acquire);
+        return id != LogSite::k_unregistered ? id : register_site(site);
+    }
+
+    uint32_t register_site(LogSite& site);
+
+    void write_site(BinaryLog& binary, uint32_t id, const LogSite& site);
+
+    // Whether the rate limit lets a line from site through. Starting a new window reports what the last one held back.
+    [[nodiscard]]
+    bool admit(LogSite& site);
+
+    void report_suppressed(LogSite& site);
+
+    void write_async();
+
+    // Hands everything queued to the sinks, followed by a note if anything was dropped since last time.
+    void flush_ring();
 };
 
 // Macros, cause why not? Not like we're using modules.
 #define H_LOG(lvl, ctx, fmt, ...)                                                          \
     do {                                                                                   \
         if ((lvl) >= Logger::get_level()) {                                                \
-            Logger::get().log((lvl), (ctx), std::format((fmt) __VA_OPT__(,) __VA_ARGS__)); \
+            static constinit LogSite h_log_site{(lvl), (ctx), (fmt), __FILE__, __LINE__};  \
+            Logger::get().log_site(h_log_site, (fmt) __VA_OPT__(,) __VA_ARGS__);           \
         }                                                                                  \
     } while (0)
 
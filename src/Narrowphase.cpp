@@ -0,0 +1,191 @@
+// Copyright 2025 RestingImmortal
+
+#include "Narrowphase.hpp"
+
+#include <bit>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define HORIZONS_NARROWPHASE_SSE2
+#endif
+
+namespace {
+    // Everything is padded to the widest batch, so no path needs a tail loop.
+    constexpr std::size_t k_batch_width = 8;
+}
+
+// Public Methods
+
+void Narrowphase::run(
+    const std::span<const CollisionProxy> proxies,
+    const std::span<const CollisionPair> candidates,
+    std::vector<CollisionPair>& hits
+) {
+    pack(proxies, candidates);
+    test_vectorized(candidates, hits);
+}
+
+void Narrowphase::run_scalar(
+    const std::span<const CollisionProxy> proxies,
+    const std::span<const CollisionPair> candidates,
+    std::vector<CollisionPair>& hits
+) {
+    pack(proxies, candidates);
+    test_scalar(candidates, hits);
+}
+
+// Private Methods
+
+void Narrowphase::pack(
+    const std::span<const CollisionProxy> proxies,
+    const std::span<const CollisionPair> candidates
+) {
+    const std::size_t padded = (candidates.size() + k_batch_width - 1) / k_batch_width * k_batch_width;
+
+    m_a_x.resize(padded);
+    m_a_y.resize(padded);
+    m_a_radius.resize(padded);
+    m_a_category.resize(padded);
+    m_a_collides_with.resize(padded);
+    m_b_x.resize(padded);
+    m_b_y.resize(padded);
+    m_b_radius.resize(padded);
+    m_b_category.resize(padded);
+    m_b_collides_with.resize(padded);
+
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        const auto& a = proxies[candidates[i].first];
+        const auto& b = proxies[candidates[i].second];
+
+        m_a_x[i] = a.x;
+        m_a_y[i] = a.y;
+        m_a_radius[i] = a.radius;
+        m_a_category[i] = a.category;
+        m_a_collides_with[i] = a.collides_with;
+        m_b_x[i] = b.x;
+        m_b_y[i] = b.y;
+        m_b_radius[i] = b.radius;
+        m_b_category[i] = b.category;
+        m_b_collides_with[i] = b.collides_with;
+    }
+
+    // Zeroed masks never pass the layer check, which is what makes the padding harmless.
+    for (std::size_t i = candidates.size(); i < padded; i++) {
+        m_a_collides_with[i] = 0;
+        m_b_collides_with[i] = 0;
+    }
+}
+
+void Narrowphase::test_scalar(
+    const std::span<const CollisionPair> candidates,
+    std::vector<CollisionPair>& hits
+) const {
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        if (!((m_a_collides_with[i] & m_b_category[i]) || (m_b_collides_with[i] & m_a_category[i]))) {
+            continue;
+        }
+
+        const float delta_x = m_b_x[i] - m_a_x[i];
+        const float delta_y = m_b_y[i] - m_a_y[i];
+        const float radius_sum = m_a_radius[i] + m_b_radius[i];
+
+        if (delta_x * delta_x + delta_y * delta_y <= radius_sum * radius_sum) {
+            hits.push_back(candidates[i]);
+        }
+    }
+}
+
+#if defined(__AVX2__)
+
+void Narrowphase::test_vectorized(
+    const std::span<const CollisionPair> candidates,
+    std::vector<CollisionPair>& hits
+) const {
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (std::size_t base = 0; base < candidates.size(); base += 8) {
+        const auto load_mask = [base](const std::vector<uint32_t>& values) {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values.data() + base));
+        };
+
+        const __m256i layers = _mm256_or_si256(
+            _mm256_and_si256(load_mask(m_a_collides_with), load_mask(m_b_category)),
+            _mm256_and_si256(load_mask(m_b_collides_with), load_mask(m_a_category))
+        );
+        const __m256 layer_pass = _mm256_castsi256_ps(
+            _mm256_xor_si256(_mm256_cmpeq_epi32(layers, zero), _mm256_set1_epi32(-1))
+        );
+
+        const __m256 delta_x = _mm256_sub_ps(_mm256_loadu_ps(m_b_x.data() + base), _mm256_loadu_ps(m_a_x.data() + base));
+        const __m256 delta_y = _mm256_sub_ps(_mm256_loadu_ps(m_b_y.data() + base), _mm256_loadu_ps(m_a_y.data() + base));
+        const __m256 radius_sum = _mm256_add_ps(
+            _mm256_loadu_ps(m_a_radius.data() + base),
+            _mm256_loadu_ps(m_b_radius.data() + base)
+        );
+
+        const __m256 dist_sq = _mm256_add_ps(_mm256_mul_ps(delta_x, delta_x), _mm256_mul_ps(delta_y, delta_y));
+        const __m256 overlap = _mm256_cmp_ps(dist_sq, _mm256_mul_ps(radius_sum, radius_sum), _CMP_LE_OQ);
+
+        for (
+            auto mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_and_ps(overlap, layer_pass)));
+            mask != 0;
+            mask &= mask - 1
+        ) {
+            hits.push_back(candidates[base + std::countr_zero(mask)]);
+        }
+    }
+}
+
+#elif defined(HORIZONS_NARROWPHASE_SSE2)
+
+void Narrowphase::test_vectorized(
+    const std::span<const CollisionPair> candidates,
+    std::vector<CollisionPair>& hits
+) const {
+    const __m128i zero = _mm_setzero_si128();
+
+    for (std::size_t base = 0; base < candidates.size(); base += 4) {
+        const auto load_mask = [base](const std::vector<uint32_t>& values) {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data() + base));
+        };
+
+        const __m128i layers = _mm_or_si128(
+            _mm_and_si128(load_mask(m_a_collides_with), load_mask(m_b_category)),
+            _mm_and_si128(load_mask(m_b_collides_with), load_mask(m_a_category))
+        );
+        const __m128 layer_pass = _mm_castsi128_ps(
+            _mm_xor_si128(_mm_cmpeq_epi32(layers, zero), _mm_set1_epi32(-1))
+        );
+
+        const __m128 delta_x = _mm_sub_ps(_mm_loadu_ps(m_b_x.data() + base), _mm_loadu_ps(m_a_x.data() + base));
+        const __m128 delta_y = _mm_sub_ps(_mm_loadu_ps(m_b_y.data() + base), _mm_loadu_ps(m_a_y.data() + base));
+        const __m128 radius_sum = _mm_add_ps(
+            _mm_loadu_ps(m_a_radius.data() + base),
+            _mm_loadu_ps(m_b_radius.data() + base)
+        );
+
+        const __m128 dist_sq = _mm_add_ps(_mm_mul_ps(delta_x, delta_x), _mm_mul_ps(delta_y, delta_y));
+        const __m128 overlap = _mm_cmple_ps(dist_sq, _mm_mul_ps(radius_sum, radius_sum));
+
+        for (
+            auto mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_and_ps(overlap, layer_pass)));
+            mask != 0;
+            mask &= mask - 1
+        ) {
+            hits.push_back(candidates[base + std::countr_zero(mask)]);
+        }
+    }
+}
+
+#else
+
+void Narrowphase::test_vectorized(
+    const std::span<const CollisionPair> candidates,
+    std::vector<CollisionPair>& hits
+) const {
+    test_scalar(candidates, hits);
+}
+
+#endif
@@ -0,0 +1,48 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CollisionProxy.hpp"
+
+// Circle vs circle tests for the broadphase candidates.
+// Candidates are packed into structure-of-arrays buffers and tested eight (AVX2) or four (SSE2) at a time,
+// with a plain scalar loop for everything else. Every path gives the same hits in the same order.
+class Narrowphase {
+public:
+    // Appends every candidate that passes the layer check and overlaps to hits, keeping candidate order.
+    void run(
+        std::span<const CollisionProxy> proxies,
+        std::span<const CollisionPair> candidates,
+        std::vector<CollisionPair>& hits
+    );
+
+    // Same as run, but always takes the scalar path. Handy for checking the vector paths against.
+    void run_scalar(
+        std::span<const CollisionProxy> proxies,
+        std::span<const CollisionPair> candidates,
+        std::vector<CollisionPair>& hits
+    );
+
+private:
+    std::vector<float> m_a_x;
+    std::vector<float> m_a_y;
+    std::vector<float> m_a_radius;
+    std::vector<uint32_t> m_a_category;
+    std::vector<uint32_t> m_a_collides_with;
+    std::vector<float> m_b_x;
+    std::vector<float> m_b_y;
+    std::vector<float> m_b_radius;
+    std::vector<uint32_t> m_b_category;
+    std::vector<uint32_t> m_b_collides_with;
+
+    // Packs the candidates, padding the tail out to a full batch with entries that can never collide.
+    void pack(std::span<const CollisionProxy> proxies, std::span<const CollisionPair> candidates);
+
+    void test_scalar(std::span<const CollisionPair> candidates, std::vector<CollisionPair>& hits) const;
+
+    void test_vectorized(std::span<const CollisionPair> candidates, std::vector<CollisionPair>& hits) const;
+};
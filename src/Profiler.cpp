@@ -0,0 +1,152 @@
+// Copyright 2025 RestingImmortal
+
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <print>
+
+// Public Methods
+
+Profiler::Profiler() : m_epoch(std::chrono::steady_clock::now()) {
+    // Allocated up front so recording never does.
+    m_trace.resize(k_trace_capacity);
+}
+
+Profiler::Stats Profiler::get_stats(const Section& section) {
+    const std::size_t count = std::min<uint64_t>(section.calls, k_window_size);
+    if (count == 0) {
+        return {};
+    }
+
+    // A copy, since nth_element shuffles it. Stays on the stack so the overlay can ask every frame.
+    std::array<std::chrono::nanoseconds, k_window_size> samples;
+    std::copy_n(section.recent.begin(), count, samples.begin());
+    const auto samples_end = samples.begin() + static_cast<std::ptrdiff_t>(count);
+
+    std::chrono::nanoseconds sum{0};
+    for (auto it = samples.begin(); it != samples_end; ++it) {
+        sum += *it;
+    }
+
+    // Smallest sample that 99% of the window is at or under.
+    const auto p99 = samples.begin() + static_cast<std::ptrdiff_t>((count * 99 + 99) / 100 - 1);
+    std::nth_element(samples.begin(), p99, samples_end);
+
+    return {
+        *std::min_element(samples.begin(), samples_end),
+        sum / static_cast<int64_t>(count),
+        *p99
+    };
+}
+
+void Profiler::print_report() const {
+    auto sections = m_sections;
+    std::ranges::sort(sections, std::ranges::greater{}, &Section::total);
+
+    std::chrono::nanoseconds total{0};
+    for (const auto& section : sections) {
+        total += section.total;
+    }
+
+    std::println("{:<32} {:>10} {:>12} {:>12} {:>12} {:>7}", "Section", "Calls", "Total ms", "Avg us", "p99 us", "Share");
+    for (const auto& section : sections) {
+        const double total_ms = std::chrono::duration<double, std::milli>(section.total).count();
+        const double average_us = std::chrono::duration<double, std::micro>(section.total).count()
+                                / static_cast<double>(std::max<uint64_t>(section.calls, 1));
+        const double p99_us = std::chrono::duration<double, std::micro>(get_stats(section).p99).count();
+        const double share = total.count() > 0
+            ? 100.0 * static_cast<double>(section.total.count()) / static_cast<double>(total.count())
+            : 0.0;
+
+        std::println(
+            "{:<32} {:>10} {:>12.3f} {:>12.3f} {:>12.3f} {:>6.1f}%",
+            section.name, section.calls, total_ms, average_us, p99_us, share
+        );
+    }
+
+    if constexpr (AllocationTracker::k_enabled) {
+        std::println();
+        std::println("{:<32} {:>14} {:>14} {:>14}", "Section", "Allocs/call", "Bytes/call", "Total bytes");
+        for (const auto& section : sections) {
+            const double calls = static_cast<double>(std::max<uint64_t>(section.calls, 1));
+            std::println(
+                "{:<32} {:>14.2f} {:>14.1f} {:>14}",
+                section.name,
+                static_cast<double>(section.allocated.allocations) / calls,
+                static_cast<double>(section.allocated.bytes) / calls,
+                section.allocated.bytes
+            );
+        }
+    }
+}
+
+bool Profiler::write_trace(const std::filesystem::path& path) const {
+    std::FILE* file = std::fopen(path.string().c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    // Oldest first, so the viewer doesn't have to sort a wrapped ring.
+    const std::size_t count = m_trace_wrapped ? k_trace_capacity : m_trace_next;
+    const std::size_t first = m_trace_wrapped ? m_trace_next : 0;
+
+    std::print(file, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (std::size_t i = 0; i < count; i++) {
+        const auto& event = m_trace[(first + i) % k_trace_capacity];
+        std::print(
+            file,
+            "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":{:.3f},\"dur\":{:.3f}}}",
+            i == 0 ? "" : ",\n",
+            m_sections[event.section].name,
+            std::chrono::duration<double, std::micro>(event.start).count(),
+            std::chrono::duration<double, std::micro>(event.duration).count()
+        );
+    }
+    std::print(file, "]}}\n");
+
+    return std::fclose(file) == 0;
+}
+
+void Profiler::reset() {
+    m_sections.clear();
+    m_trace_next = 0;
+    m_trace_wrapped = false;
+}
+
+const std::vector<Profiler::Section>& Profiler::get_sections() const {
+    return m_sections;
+}
+
+// Private Methods
+
+uint32_t Profiler::find_section(const std::string_view name) {
+    // Only a couple dozen sections, so a linear scan beats hashing the name.
+    const auto section = std::ranges::find(m_sections, name, &Section::name);
+    if (section != m_sections.end()) {
+        return static_cast<uint32_t>(section - m_sections.begin());
+    }
+
+    m_sections.push_back({.name = name});
+    return static_cast<uint32_t>(m_sections.size() - 1);
+}
+
+void Profiler::record(
+    const uint32_t section_index,
+    const std::chrono::steady_clock::time_point start,
+    const std::chrono::nanoseconds elapsed,
+    const AllocationTracker::Counts allocated
+) {
+    auto& section = m_sections[section_index];
+
+    section.recent[section.calls % k_window_size] = elapsed;
+    section.calls++;
+    section.total += elapsed;
+    section.allocated.allocations += allocated.allocations;
+    section.allocated.bytes += allocated.bytes;
+    section.last_allocated = allocated;
+
+    m_trace[m_trace_next] = {section_index, start - m_epoch, elapsed};
+    m_trace_next = (m_trace_next + 1) % k_trace_capacity;
+    m_trace_wrapped = m_trace_wrapped || m_trace_next == 0;
+}
@@ -0,0 +1,92 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "AllocationTracker.hpp"
+
+// Wall clock time spent in named sections. Keeps running totals for the whole session, a rolling window
+// of recent samples for min/avg/p99, and a ring of recent trace events that can be dumped when a hitch shows up.
+// Names are looked up by value, but should be string literals since they're kept around.
+class Profiler {
+public:
+    // Roughly four seconds of frames at 60 fps.
+    static constexpr std::size_t k_window_size = 240;
+
+    // Oldest events get overwritten once this many are stored. At around fifteen sections a tick, that's about a minute at 60 Hz.
+    static constexpr std::size_t k_trace_capacity = 1 << 16;
+
+    struct Section {
+        std::string_view name;
+        uint64_t calls = 0;
+        std::chrono::nanoseconds total{0};
+        std::array<std::chrono::nanoseconds, k_window_size> recent{};
+
+        // Stay at zero unless built with HORIZONS_TRACK_ALLOCATIONS.
+        AllocationTracker::Counts allocated;
+        AllocationTracker::Counts last_allocated;
+    };
+
+    struct Stats {
+        std::chrono::nanoseconds min{0};
+        std::chrono::nanoseconds average{0};
+        std::chrono::nanoseconds p99{0};
+    };
+
+    Profiler();
+
+    // Calls function and adds the time it took, and whatever it allocated, to the section called name.
+    // Sections can nest, in which case the outer one only gets the allocations made outside of the inner one.
+    template <typename Function>
+    void measure(const std::string_view name, Function&& function) {
+        const uint32_t section = find_section(name);
+        const uint32_t previous_scope = AllocationTracker::enter(section + 1);
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        record(section, start, elapsed, AllocationTracker::leave(previous_scope));
+    }
+
+    // Over the last k_window_size calls, or fewer if the section hasn't been called that often yet.
+    [[nodiscard]]
+    static Stats get_stats(const Section& section);
+
+    // Prints every section, slowest first.
+    void print_report() const;
+
+    // Writes the stored trace events in the Chrome trace event format, which Perfetto and chrome://tracing can open.
+    bool write_trace(const std::filesystem::path& path) const;
+
+    void reset();
+
+    [[nodiscard]]
+    const std::vector<Section>& get_sections() const;
+
+private:
+    uint32_t find_section(std::string_view name);
+
+    void record(
+        uint32_t section,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::nanoseconds elapsed,
+        AllocationTracker::Counts allocated
+    );
+
+    struct TraceEvent {
+        uint32_t section;
+        std::chrono::nanoseconds start;
+        std::chrono::nanoseconds duration;
+    };
+
+    std::chrono::steady_clock::time_point m_epoch;
+    std::vector<Section> m_sections;
+    std::vector<TraceEvent> m_trace;
+    std::size_t m_trace_next = 0;
+    bool m_trace_wrapped = false;
+};
@@ -0,0 +1,244 @@
+// Copyright 2025 RestingImmortal
+
+#include "ProjectileManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+// Public Methods
+
+void ProjectileManager::set_layers(const CollisionLayers& layers) {
+    m_layer_count = static_cast<uint32_t>(layers.names.size());
+    m_layer_masks = layers.masks;
+}
+
+void ProjectileManager::spawn(
+    const Components::Transform& transform,
+    const Components::Physics& physics,
+    const Components::Weapon& weapon,
+    const FactionId faction,
+    const raylib::TextureUnmanaged& texture
+) {
+    const float rotation_rad = transform.rotation * DEG2RAD;
+    const raylib::Vector2 velocity = physics.velocity + raylib::Vector2{std::sin(rotation_rad), -std::cos(rotation_rad)} * weapon.shot_speed;
+
+    m_x.push_back(transform.position.x);
+    m_y.push_back(transform.position.y);
+    m_previous_x.push_back(transform.position.x);
+    m_previous_y.push_back(transform.position.y);
+    m_velocity_x.push_back(velocity.x);
+    m_velocity_y.push_back(velocity.y);
+    m_rotation.push_back(transform.rotation);
+    m_lifetime.push_back(weapon.lifetime);
+    m_damage.push_back(weapon.damage);
+    m_radius.push_back(weapon.radius);
+    m_faction.push_back(faction);
+    m_layer.push_back(weapon.collision_layer);
+    m_texture.push_back(intern_texture(texture));
+}
+
+void ProjectileManager::update(const float dt) {
+    const std::size_t count = m_x.size();
+    float* x = m_x.data();
+    float* y = m_y.data();
+    float* lifetime = m_lifetime.data();
+    const float* velocity_x = m_velocity_x.data();
+    const float* velocity_y = m_velocity_y.data();
+
+    std::copy(m_x.begin(), m_x.end(), m_previous_x.begin());
+    std::copy(m_y.begin(), m_y.end(), m_previous_y.begin());
+
+    // No branches and no aliasing between the arrays, so this vectorizes.
+    for (std::size_t i = 0; i < count; i++) {
+        x[i] += velocity_x[i] * dt;
+        y[i] += velocity_y[i] * dt;
+        lifetime[i] -= dt;
+    }
+
+    compact();
+}
+
+void ProjectileManager::collide(
+    const entt::registry& registry,
+    const AssetManager& asset_manager,
+    CollisionResolver& collision_resolver
+) {
+    const std::size_t count = m_x.size();
+    if (count == 0) {
+        return;
+    }
+
+    // Targets first, then every projectile, so a pair's first index is always the target.
+    m_proxies.clear();
+    for (const auto [entity, transform, collider, affiliation] :
+         registry.view<const Components::Transform, const Components::Collider, const Components::Affiliation>().each()) {
+        if (collider.layer >= m_layer_count) {
+            continue;
+        }
+        m_proxies.push_back({
+            entity, transform.position.x, transform.position.y, collider.radius,
+            1u << collider.layer, m_layer_masks[collider.layer], affiliation.id
+        });
+    }
+    const auto target_count = static_cast<uint32_t>(m_proxies.size());
+    if (target_count == 0) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        const bool has_layer = m_layer[i] < m_layer_count;
+        m_proxies.push_back({
+            entt::null, m_x[i], m_y[i], m_radius[i],
+            has_layer ? 1u << m_layer[i] : 0u,
+            has_layer ? m_layer_masks[m_layer[i]] : 0u,
+            m_faction[i]
+        });
+    }
+
+    const std::span<const CollisionProxy> proxies = m_proxies;
+    const float cell_size = SpatialHash::choose_cell_size(proxies);
+    m_target_grid.rebuild(proxies.first(target_count), 0, cell_size);
+    m_projectile_grid.rebuild(proxies.subspan(target_count), target_count, cell_size);
+
+    // Queried from the target side, since there are usually far fewer ships than shots.
+    m_candidates.clear();
+    m_target_grid.collect_pairs_with(m_projectile_grid, 0, target_count, m_candidates);
+
+    m_hit.assign(count, 0);
+    for (const auto& [target_index, proxy_index] : m_candidates) {
+        const auto& target = m_proxies[target_index];
+        const auto& projectile = m_proxies[proxy_index];
+        const uint32_t projectile_index = proxy_index - target_count;
+
+        if (m_hit[projectile_index]) {
+            continue;
+        }
+        if (!(target.category & projectile.collides_with) || !(projectile.category & target.collides_with)) {
+            continue;
+        }
+
+        const float dx = projectile.x - target.x;
+        const float dy = projectile.y - target.y;
+        const float reach = projectile.radius + target.radius;
+        if (dx * dx + dy * dy >= reach * reach) {
+            continue;
+        }
+
+        // A projectile passing over a friendly ship keeps going.
+        if (!asset_manager.is_hostile(projectile.faction, target.faction)) {
+            continue;
+        }
+
+        m_hit[projectile_index] = 1;
+        m_lifetime[projectile_index] = 0.0f;
+        collision_resolver.push_projectile_hit(
+            target.entity, raylib::Vector2{projectile.x, projectile.y}, m_damage[projectile_index], projectile.faction
+        );
+    }
+
+    compact();
+}
+
+void ProjectileManager::render(const float alpha, std::pmr::memory_resource& frame_memory) const {
+    const std::size_t count = m_x.size();
+
+    // Counting sort by texture, so each texture's projectiles are drawn back to back.
+    std::pmr::vector<uint32_t> texture_starts(m_textures.size() + 1, 0, &frame_memory);
+    for (std::size_t i = 0; i < count; i++) {
+        texture_starts[m_texture[i] + 1]++;
+    }
+    for (std::size_t texture = 1; texture < texture_starts.size(); texture++) {
+        texture_starts[texture] += texture_starts[texture - 1];
+    }
+
+    std::pmr::vector<uint32_t> order(count, &frame_memory);
+    for (uint32_t i = 0; i < count; i++) {
+        order[texture_starts[m_texture[i]]++] = i;
+    }
+
+    for (const uint32_t i : order) {
+        const auto& texture = m_textures[m_texture[i]];
+        if (texture.id == 0) {
+            continue;
+        }
+
+        const float width = static_cast<float>(texture.width);
+        const float height = static_cast<float>(texture.height);
+
+        texture.Draw(
+            raylib::Rectangle{0, 0, width, height},
+            raylib::Rectangle{
+                m_previous_x[i] + (m_x[i] - m_previous_x[i]) * alpha,
+                m_previous_y[i] + (m_y[i] - m_previous_y[i]) * alpha,
+                width,
+                height
+            },
+            raylib::Vector2{width / 2.0f, height / 2.0f},
+            m_rotation[i],
+            raylib::Color::White()
+        );
+    }
+}
+
+std::size_t ProjectileManager::size() const {
+    return m_x.size();
+}
+
+// Private Methods
+
+void ProjectileManager::compact() {
+    const std::size_t count = m_x.size();
+    std::size_t kept = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (m_lifetime[i] <= 0.0f) {
+            continue;
+        }
+        if (kept != i) {
+            m_x[kept] = m_x[i];
+            m_y[kept] = m_y[i];
+            m_previous_x[kept] = m_previous_x[i];
+            m_previous_y[kept] = m_previous_y[i];
+            m_velocity_x[kept] = m_velocity_x[i];
+            m_velocity_y[kept] = m_velocity_y[i];
+            m_rotation[kept] = m_rotation[i];
+            m_lifetime[kept] = m_lifetime[i];
+            m_damage[kept] = m_damage[i];
+            m_radius[kept] = m_radius[i];
+            m_faction[kept] = m_faction[i];
+            m_layer[kept] = m_layer[i];
+            m_texture[kept] = m_texture[i];
+        }
+        kept++;
+    }
+
+    if (kept == count) {
+        return;
+    }
+
+    m_x.resize(kept);
+    m_y.resize(kept);
+    m_previous_x.resize(kept);
+    m_previous_y.resize(kept);
+    m_velocity_x.resize(kept);
+    m_velocity_y.resize(kept);
+    m_rotation.resize(kept);
+    m_lifetime.resize(kept);
+    m_damage.resize(kept);
+    m_radius.resize(kept);
+    m_faction.resize(kept);
+    m_layer.resize(kept);
+    m_texture.resize(kept);
+}
+
+uint32_t ProjectileManager::intern_texture(const raylib::TextureUnmanaged& texture) {
+    // Only a handful of munitions, so a scan is fine.
+    for (uint32_t index = 0; index < m_textures.size(); index++) {
+        if (m_textures[index].id == texture.id) {
+            return index;
+        }
+    }
+    m_textures.push_back(texture);
+    return static_cast<uint32_t>(m_textures.size() - 1);
+}
@@ -0,0 +1,84 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <raylib-cpp.hpp>
+
+#include "AssetManager.hpp"
+#include "CollisionProxy.hpp"
+#include "CollisionResolver.hpp"
+#include "Components.hpp"
+#include "SpatialHash.hpp"
+
+// Projectiles kept out of the registry entirely, as packed arrays with one element per projectile.
+// Opt-in through soa_projectiles in META.json. Bullets are the most numerous thing in a fight, and as entities each one
+// is spread across seven storages. Here moving and expiring all of them is a couple of straight loops over floats.
+//
+// Projectiles collide against entity colliders only, never each other, and hits are handed to the CollisionResolver
+// so they're filtered and applied exactly like bullet hits.
+class ProjectileManager {
+public:
+    // Needs to be called once the assets are loaded. Until then, nothing collides.
+    void set_layers(const CollisionLayers& layers);
+
+    void spawn(
+        const Components::Transform& transform,
+        const Components::Physics& physics,
+        const Components::Weapon& weapon,
+        FactionId faction,
+        const raylib::TextureUnmanaged& texture
+    );
+
+    // Moves everything along and drops whatever ran out of lifetime.
+    void update(float dt);
+
+    // Tests every projectile against the colliders in the registry. Each projectile hits at most one target that's hostile to it,
+    // is removed, and has its hit passed on to collision_resolver.
+    void collide(const entt::registry& registry, const AssetManager& asset_manager, CollisionResolver& collision_resolver);
+
+    // Draws every projectile, one texture at a time so raylib can batch them.
+    void render(float alpha, std::pmr::memory_resource& frame_memory) const;
+
+    [[nodiscard]]
+    std::size_t size() const;
+
+private:
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_previous_x;
+    std::vector<float> m_previous_y;
+    std::vector<float> m_velocity_x;
+    std::vector<float> m_velocity_y;
+    std::vector<float> m_rotation;
+    std::vector<float> m_lifetime;
+    std::vector<float> m_damage;
+    std::vector<float> m_radius;
+    std::vector<FactionId> m_faction;
+    std::vector<uint32_t> m_layer;
+    std::vector<uint32_t> m_texture;
+
+    // Each munition texture is stored once and referred to by index.
+    std::vector<raylib::TextureUnmanaged> m_textures;
+
+    uint32_t m_layer_count = 0;
+    std::array<uint32_t, CollisionLayers::k_max_layers> m_layer_masks{};
+
+    // Collision scratch, kept between ticks.
+    std::vector<CollisionProxy> m_proxies;
+    std::vector<CollisionPair> m_candidates;
+    std::vector<uint8_t> m_hit;
+    SpatialHash m_target_grid;
+    SpatialHash m_projectile_grid;
+
+    // Drops every projectile whose lifetime is used up, keeping the rest in order.
+    void compact();
+
+    [[nodiscard]]
+    uint32_t intern_texture(const raylib::TextureUnmanaged& texture);
+};
@@ -0,0 +1,35 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstdint>
+
+// Seconds of simulation so far. It only moves when the game ticks, so timers measured against it
+// pause with the simulation and keep up when headless runs go faster than real time.
+class SimClock {
+public:
+    [[nodiscard]]
+    static double now() noexcept {
+        return s_now;
+    }
+
+    // How many times advance has been called, for things that care about ticks rather than seconds.
+    [[nodiscard]]
+    static uint64_t ticks() noexcept {
+        return s_ticks;
+    }
+
+    static void advance(const double dt) noexcept {
+        s_now += dt;
+        s_ticks++;
+    }
+
+    static void reset() noexcept {
+        s_now = 0.0;
+        s_ticks = 0;
+    }
+
+private:
+    inline static double s_now = 0.0;
+    inline static uint64_t s_ticks = 0;
+};
@@ -0,0 +1,210 @@
+// Copyright 2025 RestingImmortal
+
+#include "SpatialHash.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+    // Keeps the grid usable when every collider has a radius of zero.
+    constexpr float k_min_cell_size = 1.0f;
+
+    // A single huge collider shouldn't be allowed to cover thousands of cells,
+    // so the cell size never drops below this fraction of the largest radius.
+    constexpr float k_cells_per_max_radius = 4.0f;
+
+    // Cells are clamped well inside int32_t, so something flung far out of the world lands in the edge cells instead
+    // of being undefined to convert, and the cell count of a range can't overflow.
+    constexpr float k_max_cell = 536'870'912.0f; // 2^29
+
+    int32_t cell_of(const float scaled) {
+        return static_cast<int32_t>(std::clamp(std::floor(scaled), -k_max_cell, k_max_cell));
+    }
+}
+
+float SpatialHash::choose_cell_size(const std::span<const CollisionProxy> proxies) {
+    float radius_sum = 0.0f;
+    float radius_max = 0.0f;
+    for (const auto& proxy : proxies) {
+        // rebuild skips these anyway, and one infinite radius would make every cell infinitely big.
+        if (!std::isfinite(proxy.radius)) {
+            continue;
+        }
+        radius_sum += proxy.radius;
+        radius_max = std::max(radius_max, proxy.radius);
+    }
+    const float radius_mean = proxies.empty() ? 0.0f : radius_sum / static_cast<float>(proxies.size());
+
+    // Cells roughly one average collider across keep most proxies in one to four cells.
+    return std::max({2.0f * radius_mean, radius_max / k_cells_per_max_radius, k_min_cell_size});
+}
+
+void SpatialHash::rebuild(
+    const std::span<const CollisionProxy> proxies,
+    const uint32_t base_index,
+    const float cell_size
+) {
+    m_ranges.clear();
+    m_entries.clear();
+
+    m_base_index = base_index;
+    m_cell_size = cell_size;
+    m_inverse_cell_size = 1.0f / m_cell_size;
+
+    std::size_t entry_count = 0;
+    m_ranges.reserve(proxies.size());
+    for (const auto& proxy : proxies) {
+        // Scaled before adding, so a huge position plus a huge radius can't overflow into an infinitely wide range.
+        const float x = proxy.x * m_inverse_cell_size;
+        const float y = proxy.y * m_inverse_cell_size;
+        const float radius = proxy.radius * m_inverse_cell_size;
+        const float min_x = x - radius;
+        const float min_y = y - radius;
+        const float max_x = x + radius;
+        const float max_y = y + radius;
+
+        // A NaN, infinity, or negative radius got in somewhere. There's no sensible cell for it, so it gets an empty
+        // range and collides with nothing, instead of walking every cell between here and the edge of the grid.
+        const bool usable =
+            std::isfinite(proxy.x) && std::isfinite(proxy.y) && std::isfinite(proxy.radius) && proxy.radius >= 0.0f;
+        if (!usable || std::isnan(min_x + min_y + max_x + max_y)) {
+            m_ranges.push_back({0, 0, -1, -1});
+            continue;
+        }
+
+        // Since the cell size is at least a quarter of the biggest radius, a range is never more than a few cells across.
+        const CellRange range = {cell_of(min_x), cell_of(min_y), cell_of(max_x), cell_of(max_y)};
+        entry_count += static_cast<std::size_t>(range.max_x - range.min_x + 1)
+                     * static_cast<std::size_t>(range.max_y - range.min_y + 1);
+        m_ranges.push_back(range);
+    }
+
+    // Twice as many buckets as entries keeps unrelated cells from piling into the same bucket.
+    const std::size_t bucket_count = std::bit_ceil(std::max<std::size_t>(entry_count * 2, 1));
+    m_bucket_mask = static_cast<uint32_t>(bucket_count - 1);
+    m_bucket_starts.assign(bucket_count + 1, 0);
+
+    for (const auto& range : m_ranges) {
+        for (int32_t cell_y = range.min_y; cell_y <= range.max_y; cell_y++) {
+            for (int32_t cell_x = range.min_x; cell_x <= range.max_x; cell_x++) {
+                m_bucket_starts[bucket_of(cell_x, cell_y) + 1]++;
+            }
+        }
+    }
+
+    for (std::size_t bucket = 1; bucket <= bucket_count; bucket++) {
+        m_bucket_starts[bucket] += m_bucket_starts[bucket - 1];
+    }
+
+    // Counting sort into buckets. Proxies are walked in order, so every bucket stays sorted by proxy index.
+    m_entries.resize(entry_count);
+    m_bucket_cursors.assign(m_bucket_starts.begin(), m_bucket_starts.end() - 1);
+    for (uint32_t proxy = 0; proxy < m_ranges.size(); proxy++) {
+        const auto& range = m_ranges[proxy];
+        for (int32_t cell_y = range.min_y; cell_y <= range.max_y; cell_y++) {
+            for (int32_t cell_x = range.min_x; cell_x <= range.max_x; cell_x++) {
+                m_entries[m_bucket_cursors[bucket_of(cell_x, cell_y)]++] = {cell_x, cell_y, proxy};
+            }
+        }
+    }
+}
+
+void SpatialHash::collect_pairs(
+    const uint32_t first,
+    const uint32_t last,
+    std::vector<CollisionPair>& out
+) const {
+    for (uint32_t proxy = first; proxy < last; proxy++) {
+        const auto& range = m_ranges[proxy];
+
+        for (int32_t cell_y = range.min_y; cell_y <= range.max_y; cell_y++) {
+            for (int32_t cell_x = range.min_x; cell_x <= range.max_x; cell_x++) {
+                const uint32_t bucket = bucket_of(cell_x, cell_y);
+                const auto bucket_begin = m_entries.begin() + m_bucket_starts[bucket];
+                const auto bucket_end   = m_entries.begin() + m_bucket_starts[bucket + 1];
+
+                // Only look at proxies after this one, so every pair is visited from its lower index.
+                const auto later = std::upper_bound(
+                    bucket_begin, bucket_end, proxy,
+                    [](const uint32_t value, const Entry& entry) { return value < entry.proxy; }
+                );
+
+                for (auto it = later; it != bucket_end; ++it) {
+                    // Different cells can share a bucket.
+                    if (it->cell_x != cell_x || it->cell_y != cell_y) {
+                        continue;
+                    }
+
+                    // Two proxies can share several cells; only report from the lowest of them.
+                    const auto& other = m_ranges[it->proxy];
+                    if (
+                        cell_x != std::max(range.min_x, other.min_x) ||
+                        cell_y != std::max(range.min_y, other.min_y)
+                    ) {
+                        continue;
+                    }
+
+                    out.push_back({m_base_index + proxy, m_base_index + it->proxy});
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::collect_pairs_with(
+    const SpatialHash& other,
+    const uint32_t first,
+    const uint32_t last,
+    std::vector<CollisionPair>& out
+) const {
+    if (other.m_entries.empty()) {
+        return;
+    }
+
+    for (uint32_t proxy = first; proxy < last; proxy++) {
+        const auto& range = m_ranges[proxy];
+
+        for (int32_t cell_y = range.min_y; cell_y <= range.max_y; cell_y++) {
+            for (int32_t cell_x = range.min_x; cell_x <= range.max_x; cell_x++) {
+                const uint32_t bucket = other.bucket_of(cell_x, cell_y);
+                const auto bucket_begin = other.m_entries.begin() + other.m_bucket_starts[bucket];
+                const auto bucket_end   = other.m_entries.begin() + other.m_bucket_starts[bucket + 1];
+
+                for (auto it = bucket_begin; it != bucket_end; ++it) {
+                    if (it->cell_x != cell_x || it->cell_y != cell_y) {
+                        continue;
+                    }
+
+                    const auto& other_range = other.m_ranges[it->proxy];
+                    if (
+                        cell_x != std::max(range.min_x, other_range.min_x) ||
+                        cell_y != std::max(range.min_y, other_range.min_y)
+                    ) {
+                        continue;
+                    }
+
+                    const uint32_t a = m_base_index + proxy;
+                    const uint32_t b = other.m_base_index + it->proxy;
+                    out.push_back({std::min(a, b), std::max(a, b)});
+                }
+            }
+        }
+    }
+}
+
+uint32_t SpatialHash::size() const {
+    return static_cast<uint32_t>(m_ranges.size());
+}
+
+float SpatialHash::get_cell_size() const {
+    return m_cell_size;
+}
+
+// Private methods
+
+uint32_t SpatialHash::bucket_of(const int32_t cell_x, const int32_t cell_y) const {
+    uint32_t hash = (static_cast<uint32_t>(cell_x) * 0x9E3779B1u) ^ (static_cast<uint32_t>(cell_y) * 0x85EBCA77u);
+    hash ^= hash >> 16;
+    return hash & m_bucket_mask;
+}
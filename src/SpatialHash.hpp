@@ -0,0 +1,61 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CollisionProxy.hpp"
+
+// Uniform grid broadphase, stored as a hash so the world doesn't need bounds.
+// Every proxy is inserted into each cell its bounding box touches, and a pair is only
+// reported from the lowest cell the two share, so each candidate shows up exactly once.
+class SpatialHash {
+public:
+    // Picks a cell size from the radii of the proxies. Grids that get queried against each other have to share one.
+    [[nodiscard]]
+    static float choose_cell_size(std::span<const CollisionProxy> proxies);
+
+    // Rebuilds the whole grid. Proxies are numbered from base_index, so pairs come out as indices into the full proxy array.
+    void rebuild(std::span<const CollisionProxy> proxies, uint32_t base_index, float cell_size);
+
+    // Appends every pair inside this grid whose first proxy sits at a local position in [first, last).
+    // Pairs come out ordered by their first index, so splitting the range doesn't change the result.
+    void collect_pairs(uint32_t first, uint32_t last, std::vector<CollisionPair>& out) const;
+
+    // Appends every pair between a proxy at a local position in [first, last) of this grid and any proxy of other.
+    void collect_pairs_with(const SpatialHash& other, uint32_t first, uint32_t last, std::vector<CollisionPair>& out) const;
+
+    [[nodiscard]]
+    uint32_t size() const;
+
+    [[nodiscard]]
+    float get_cell_size() const;
+
+private:
+    struct CellRange {
+        int32_t min_x;
+        int32_t min_y;
+        int32_t max_x;
+        int32_t max_y;
+    };
+
+    struct Entry {
+        int32_t cell_x;
+        int32_t cell_y;
+        uint32_t proxy;
+    };
+
+    float m_cell_size = 1.0f;
+    float m_inverse_cell_size = 1.0f;
+    uint32_t m_base_index = 0;
+    uint32_t m_bucket_mask = 0;
+    std::vector<CellRange> m_ranges;
+    std::vector<uint32_t> m_bucket_starts;
+    std::vector<uint32_t> m_bucket_cursors;
+    std::vector<Entry> m_entries;
+
+    [[nodiscard]]
+    uint32_t bucket_of(int32_t cell_x, int32_t cell_y) const;
+};
@@ -0,0 +1,155 @@
+// Copyright 2025 RestingImmortal
+
+#include "SweepAndPrune.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+void SweepAndPrune::update(const std::span<const CollisionProxy> proxies, const uint32_t base_index) {
+    // Index this tick's proxies by entity, so the old intervals can find their proxy again.
+    for (uint32_t index = 0; index < proxies.size(); index++) {
+        const auto key = entt::to_entity(proxies[index].entity);
+        if (key >= m_proxy_of_entity.size()) {
+            m_proxy_of_entity.resize(key + 1, k_absent);
+        }
+        m_proxy_of_entity[key] = index;
+    }
+
+    // Refresh the surviving intervals in place, keeping their order so the list stays nearly sorted.
+    // A claimed proxy is cleared from the index so it isn't added a second time below.
+    std::size_t kept = 0;
+    for (const auto& interval : m_intervals) {
+        const auto key = entt::to_entity(interval.entity);
+        if (key >= m_proxy_of_entity.size()) {
+            continue;
+        }
+
+        const uint32_t index = m_proxy_of_entity[key];
+        if (index == k_absent || proxies[index].entity != interval.entity) {
+            continue;
+        }
+
+        m_proxy_of_entity[key] = k_absent;
+        if (is_usable(proxies[index])) {
+            m_intervals[kept++] = make_interval(proxies[index], base_index + index);
+        }
+    }
+    m_intervals.resize(kept);
+
+    // Whatever is left in the index is new this tick.
+    m_incoming.clear();
+    for (uint32_t index = 0; index < proxies.size(); index++) {
+        const auto key = entt::to_entity(proxies[index].entity);
+        if (m_proxy_of_entity[key] == index) {
+            if (is_usable(proxies[index])) {
+                m_incoming.push_back(make_interval(proxies[index], base_index + index));
+            }
+            m_proxy_of_entity[key] = k_absent;
+        }
+    }
+
+    // Insertion sort, since the previous order is almost right.
+    for (std::size_t i = 1; i < m_intervals.size(); i++) {
+        const Interval interval = m_intervals[i];
+        std::size_t j = i;
+        while (j > 0 && precedes(interval, m_intervals[j - 1])) {
+            m_intervals[j] = m_intervals[j - 1];
+            j--;
+        }
+        m_intervals[j] = interval;
+    }
+
+    // New intervals land anywhere, so sort them on their own and merge them in.
+    if (!m_incoming.empty()) {
+        std::ranges::sort(m_incoming, precedes);
+
+        m_merged.clear();
+        std::ranges::merge(m_intervals, m_incoming, std::back_inserter(m_merged), precedes);
+        std::swap(m_intervals, m_merged);
+    }
+}
+
+void SweepAndPrune::collect_pairs(
+    const uint32_t first,
+    const uint32_t last,
+    std::vector<CollisionPair>& out
+) const {
+    for (uint32_t position = first; position < last; position++) {
+        const auto& a = m_intervals[position];
+
+        for (std::size_t next = position + 1; next < m_intervals.size(); next++) {
+            const auto& b = m_intervals[next];
+
+            if (b.min_x > a.max_x) {
+                break;
+            }
+
+            if (!overlaps_y(a, b)) {
+                continue;
+            }
+
+            out.push_back({std::min(a.proxy, b.proxy), std::max(a.proxy, b.proxy)});
+        }
+    }
+}
+
+void SweepAndPrune::collect_pairs_with(
+    const SweepAndPrune& other,
+    const uint32_t first,
+    const uint32_t last,
+    const bool inclusive,
+    std::vector<CollisionPair>& out
+) const {
+    for (uint32_t position = first; position < last; position++) {
+        const auto& a = m_intervals[position];
+
+        const auto start = std::ranges::partition_point(other.m_intervals, [&a, inclusive](const Interval& b) {
+            return inclusive ? b.min_x < a.min_x : b.min_x <= a.min_x;
+        });
+
+        for (auto it = start; it != other.m_intervals.end(); ++it) {
+            if (it->min_x > a.max_x) {
+                break;
+            }
+
+            if (!overlaps_y(a, *it)) {
+                continue;
+            }
+
+            out.push_back({std::min(a.proxy, it->proxy), std::max(a.proxy, it->proxy)});
+        }
+    }
+}
+
+uint32_t SweepAndPrune::size() const {
+    return static_cast<uint32_t>(m_intervals.size());
+}
+
+// Private methods
+
+bool SweepAndPrune::precedes(const Interval& a, const Interval& b) {
+    // Ties fall back to the proxy index, so equal positions still sort the same way every run.
+    return a.min_x < b.min_x || (a.min_x == b.min_x && a.proxy < b.proxy);
+}
+
+bool SweepAndPrune::is_usable(const CollisionProxy& proxy) {
+    // A NaN bound would break the ordering every sort and search here relies on, so those colliders never get an
+    // interval and collide with nothing, the same as in the SpatialHash.
+    return std::isfinite(proxy.x) && std::isfinite(proxy.y) && std::isfinite(proxy.radius) && proxy.radius >= 0.0f;
+}
+
+bool SweepAndPrune::overlaps_y(const Interval& a, const Interval& b) {
+    return a.min_y <= b.max_y && b.min_y <= a.max_y;
+}
+
+SweepAndPrune::Interval SweepAndPrune::make_interval(const CollisionProxy& proxy, const uint32_t index) {
+    return {
+        .min_x = proxy.x - proxy.radius,
+        .max_x = proxy.x + proxy.radius,
+        .min_y = proxy.y - proxy.radius,
+        .max_y = proxy.y + proxy.radius,
+        .entity = proxy.entity,
+        .proxy = index
+    };
+}
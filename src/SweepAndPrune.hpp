@@ -0,0 +1,64 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "CollisionProxy.hpp"
+
+// Sort and sweep broadphase along the x axis.
+// The interval list survives between ticks and is re-sorted with an insertion sort, which is close to linear
+// since most things only move a little each frame. Unlike a grid, it doesn't fall apart when a fleet piles into one spot.
+class SweepAndPrune {
+public:
+    // Matches the persistent intervals up with this tick's proxies, drops the ones that are gone, adds new ones, and re-sorts.
+    // Proxies are numbered from base_index, so pairs come out as indices into the full proxy array.
+    void update(std::span<const CollisionProxy> proxies, uint32_t base_index);
+
+    // Appends every candidate pair whose lower interval sits at a sorted position in [first, last).
+    void collect_pairs(uint32_t first, uint32_t last, std::vector<CollisionPair>& out) const;
+
+    // Appends every pair between an interval at a sorted position in [first, last) and an interval of other that starts after it.
+    // Sweeping a against b inclusively and b against a exclusively finds every pair between the two exactly once.
+    void collect_pairs_with(
+        const SweepAndPrune& other,
+        uint32_t first,
+        uint32_t last,
+        bool inclusive,
+        std::vector<CollisionPair>& out
+    ) const;
+
+    [[nodiscard]]
+    uint32_t size() const;
+
+private:
+    struct Interval {
+        float min_x;
+        float max_x;
+        float min_y;
+        float max_y;
+        entt::entity entity;
+        uint32_t proxy;
+    };
+
+    static constexpr uint32_t k_absent = UINT32_MAX;
+
+    std::vector<Interval> m_intervals;
+    std::vector<Interval> m_incoming;
+    std::vector<Interval> m_merged;
+    std::vector<uint32_t> m_proxy_of_entity;
+
+    static bool precedes(const Interval& a, const Interval& b);
+
+    // Whether a proxy can be given an interval at all. Ones that can't are left out, and never collide.
+    [[nodiscard]]
+    static bool is_usable(const CollisionProxy& proxy);
+
+    static Interval make_interval(const CollisionProxy& proxy, uint32_t index);
+
+    static bool overlaps_y(const Interval& a, const Interval& b);
+};
@@ -2,8 +2,14 @@
 
 #include "Systems.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <print>
+#include <span>
+#include <tuple>
+#include <vector>
 
 #include <raylib-cpp.hpp>
 
@@ -15,18 +21,32 @@
 
 void camera_to_player(
     entt::registry& registry,
-    raylib::Camera2D& camera
+    raylib::Camera2D& camera,
+    const float alpha
 ) {
     const auto view = registry.view<Components::Transform, Components::Player>();
-    view.each([&camera](const auto& transform) {
+    view.each([&registry, &camera, alpha](const auto entity, const auto& transform) {
         camera.SetOffset(raylib::Vector2{GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f});
-        camera.SetTarget(transform.position);
+
+        // Has to follow the same in-between position the player is drawn at, or the ship jitters on screen.
+        const auto* previous = registry.try_get<Components::PreviousTransform>(entity);
+        camera.SetTarget(previous ? interpolate_transform(transform, *previous, alpha).position : transform.position);
     });
 }
 
-void despawn_entities(entt::registry &registry) {
+void despawn_entities(
+    entt::registry& registry,
+    std::pmr::memory_resource& frame_memory
+) {
+    // Weapons and engines go with their ship, otherwise they'd be left following an entity that no longer exists.
+    for (const auto [entity, parent] : registry.view<Components::Parent>().each()) {
+        if (registry.all_of<Components::DespawnMarker>(parent.parent)) {
+            registry.emplace_or_replace<Components::DespawnMarker>(entity);
+        }
+    }
+
     const auto view = registry.view<Components::DespawnMarker>();
-    std::vector<entt::entity> entities_to_destroy;
+    std::pmr::vector<entt::entity> entities_to_destroy(&frame_memory);
 
     for (auto entity : view) {
         entities_to_destroy.push_back(entity);
@@ -71,21 +91,48 @@ void load_map(
             );
         }
 
+        // Ships are spawned a group at a time, one group for each ship type and affiliation.
+        std::vector<const MapData::ShipMapData*> ships;
+        ships.reserve(map_data->ships.size());
         for (const auto& ship : map_data->ships) {
+            ships.push_back(&ship);
+        }
+        std::ranges::stable_sort(ships, {}, [](const MapData::ShipMapData* ship) {
+            return std::tie(ship->ship_type, ship->affiliation);
+        });
+
+        std::vector<raylib::Vector2> positions;
+        std::vector<entt::entity> spawned;
+        for (auto group_start = ships.begin(); group_start != ships.end();) {
+            const auto& first = **group_start;
+            const auto group_end = std::find_if(group_start, ships.end(), [&first](const MapData::ShipMapData* ship) {
+                return ship->ship_type != first.ship_type || ship->affiliation != first.affiliation;
+            });
+
             if (
-                auto affiliation_result = asset_manager.get_faction_id(ship.affiliation);
+                auto affiliation_result = asset_manager.get_faction_id(first.affiliation);
                 !affiliation_result
             ) {
                 H_WARNING("load_map", "{}: {}", key, affiliation_result.error());
+            } else if (
+                auto ship_result = asset_manager.get_ship_id(first.ship_type);
+                !ship_result
+            ) {
+                // spawn_ship reports the missing ship and puts a stand-in where each one should be.
+                for (auto it = group_start; it != group_end; ++it) {
+                    spawn_ship(registry, asset_manager, (*it)->ship_type, raylib::Vector2{(*it)->x, (*it)->y}, *affiliation_result);
+                }
             } else {
-                spawn_ship(
-                    registry,
-                    asset_manager,
-                    ship.ship_type,
-                    raylib::Vector2{ship.x, ship.y},
-                    *affiliation_result
-                );
+                positions.clear();
+                for (auto it = group_start; it != group_end; ++it) {
+                    positions.emplace_back((*it)->x, (*it)->y);
+                }
+                spawned.resize(positions.size());
+
+                spawn_ships(registry, asset_manager.get_ship_prefab(*ship_result), positions, *affiliation_result, spawned);
             }
+
+            group_start = group_end;
         }
 
         for (const auto& object : map_data->objects) {
@@ -126,79 +173,18 @@ void load_start(
     }
 }
 
-void mark_bullets_for_despawn(entt::registry &registry) {
-    for (
-        const auto view = registry.view<Components::Bullet>();
-        const auto entity : view
-    ) {
-        if (auto& bullet = registry.get<Components::Bullet>(entity);
-            bullet.despawn_timer.is_done()) {
-            registry.emplace_or_replace<Components::DespawnMarker>(entity);
-        }
-    }
-}
-
-void on_collision(
+void mark_bullets_for_despawn(
     entt::registry& registry,
-    const AssetManager& asset_manager,
-    const Events::Collision& event
+    BulletPool& bullet_pool
 ) {
-    const auto* a_affiliation = registry.try_get<Components::Affiliation>(event.a);
-    const auto* b_affiliation = registry.try_get<Components::Affiliation>(event.b);
-
-    if (!a_affiliation || !b_affiliation) {
-        return;
-    }
-
-    const auto relation_ab = asset_manager.get_relation(a_affiliation->id, b_affiliation->id);
-    if (!relation_ab) {
-        H_WARNING("Collision", "{}", relation_ab.error());
-        return;
-    }
-
-    const auto relation_ba = asset_manager.get_relation(b_affiliation->id, a_affiliation->id);
-    if (!relation_ba) {
-        H_WARNING("Collision", "{}", relation_ba.error());
-        return;
-    }
-
-    if (*relation_ab >= 0 && *relation_ba >= 0) {
-        return;
-    }
-
-    H_INFO("Collision", "With values of ({},{})", *relation_ab, *relation_ba);
-
-    const bool a_is_bullet = registry.all_of<Components::Bullet>(event.a);
-    const bool b_is_bullet = registry.all_of<Components::Bullet>(event.b);
-
-    if (a_is_bullet == b_is_bullet) {
-        return;
-    }
-
-    const auto [bullet_entity, target_entity] = a_is_bullet
-        ? std::pair{event.a, event.b}
-        : std::pair{event.b, event.a};
-
-    registry.emplace_or_replace<Components::DespawnMarker>(bullet_entity);
-
-    const auto* bullet_transform = registry.try_get<Components::Transform>(bullet_entity);
-    const auto* target_transform = registry.try_get<Components::Transform>(target_entity);
-
-    if (!bullet_transform || !target_transform) {
-        return;
-    }
-
-    switch (calculate_direction(*target_transform, *bullet_transform)) {
-        case HitQuadrant::Front: H_INFO("Collision", "Front!"); break;
-        case HitQuadrant::Right: H_INFO("Collision", "Right!"); break;
-        case HitQuadrant::Back:  H_INFO("Collision", "Back!");  break;
-        case HitQuadrant::Left:  H_INFO("Collision", "Left!");  break;
-    }
+    bullet_pool.release_expired(registry);
 }
 
 void player_movement(
     entt::registry& registry,
     AssetManager& asset_manager,
+    BulletPool& bullet_pool,
+    ProjectileManager* projectiles,
     const float dt
 ) {
     for (
@@ -266,7 +252,11 @@ void player_movement(
                 auto&weapon_transform = weapons.get<Components::Transform>(weapon_entity);
 
                 if (weapon.fire_timer.is_done()) {
-                    spawn_bullet(registry, asset_manager, weapon_transform, physics, weapon, affiliation.id);
+                    if (projectiles) {
+                        projectiles->spawn(weapon_transform, physics, weapon, affiliation.id, asset_manager.get_texture(weapon.munition));
+                    } else {
+                        spawn_bullet(registry, asset_manager, bullet_pool, weapon_transform, physics, weapon, affiliation.id);
+                    }
                     weapon.fire_timer.start(weapon.cooldown);
                 }
             };
@@ -378,27 +368,65 @@ void print_weapon(
     }
 }
 
-void render_sprites(entt::registry& registry) {
-    const auto view = registry.view<
-        Components::Transform,
-        Components::Renderable,
-        Components::RenderOrder>
-        (entt::exclude<Components::ShouldNotRender>);
+void render_profiler_overlay(const Profiler& profiler) {
+    constexpr int font_size = 10;
+    constexpr int line_height = 12;
+    constexpr int padding = 6;
+    constexpr int width = AllocationTracker::k_enabled ? 380 : 330;
+
+    // The default font isn't monospaced, so every column gets a fixed position instead of padding.
+    constexpr std::array columns = {170, 220, 270, 320};
+
+    const auto& sections = profiler.get_sections();
+    const int height = static_cast<int>(sections.size() + 1) * line_height + padding * 2;
+
+    DrawRectangle(0, 0, width, height, Fade(BLACK, 0.7f));
+    DrawText("ms", padding, padding, font_size, RAYWHITE);
+    DrawText("min", columns[0], padding, font_size, RAYWHITE);
+    DrawText("avg", columns[1], padding, font_size, RAYWHITE);
+    DrawText("p99", columns[2], padding, font_size, RAYWHITE);
+    if constexpr (AllocationTracker::k_enabled) {
+        DrawText("allocs", columns[3], padding, font_size, RAYWHITE);
+    }
 
-    std::vector<entt::entity> sorted_entities;
+    int y = padding + line_height;
+    for (const auto& section : sections) {
+        const auto stats = Profiler::get_stats(section);
+        const std::array times = {stats.min, stats.average, stats.p99};
 
-    for (auto entity : view) {
-        sorted_entities.push_back(entity);
+        DrawText(
+            TextFormat("%.*s", static_cast<int>(section.name.size()), section.name.data()),
+            padding, y, font_size, RAYWHITE
+        );
+        for (std::size_t column = 0; column < times.size(); column++) {
+            DrawText(
+                TextFormat("%.3f", std::chrono::duration<double, std::milli>(times[column]).count()),
+                columns[column], y, font_size, RAYWHITE
+            );
+        }
+        if constexpr (AllocationTracker::k_enabled) {
+            DrawText(TextFormat("%llu", static_cast<unsigned long long>(section.last_allocated.allocations)), columns[3], y, font_size, RAYWHITE);
+        }
+        y += line_height;
     }
+}
 
-    std::ranges::sort(sorted_entities,
-                      [&registry](const entt::entity a, const entt::entity b) {
-                          return registry.get<Components::RenderOrder>(a).layer < registry.get<Components::RenderOrder>(b).layer;
-                      }
-    );
+void render_sprites(
+    entt::registry& registry,
+    const float alpha,
+    std::pmr::memory_resource& frame_memory
+) {
+    const auto view = registry.view<Components::Transform, Components::Renderable>();
+
+    std::pmr::vector<entt::entity> sorted_entities(&frame_memory);
+    sort_sprites(registry, sorted_entities);
 
     for (const auto entity : sorted_entities) {
-        const auto& [transform, renderable] = view.get<Components::Transform, Components::Renderable>(entity);
+        const auto& [current_transform, renderable] = view.get<Components::Transform, Components::Renderable>(entity);
+
+        // Anything spawned during the last tick has nothing to blend from yet.
+        const auto* previous = registry.try_get<Components::PreviousTransform>(entity);
+        const auto transform = previous ? interpolate_transform(current_transform, *previous, alpha) : current_transform;
 
         const raylib::Rectangle source_rec = {
             0, 0,
@@ -421,6 +449,38 @@ void render_sprites(entt::registry& registry) {
     }
 }
 
+void resolve_collisions(
+    entt::registry& registry,
+    const AssetManager& asset_manager,
+    CollisionResolver& collision_resolver,
+    BulletPool& bullet_pool
+) {
+    collision_resolver.resolve(registry, asset_manager, bullet_pool);
+}
+
+void sort_sprites(
+    entt::registry& registry,
+    std::pmr::vector<entt::entity>& sorted_entities
+) {
+    const auto view = registry.view<
+        Components::Transform,
+        Components::Renderable,
+        Components::RenderOrder>
+        (entt::exclude<Components::ShouldNotRender>);
+
+    sorted_entities.clear();
+
+    for (auto entity : view) {
+        sorted_entities.push_back(entity);
+    }
+
+    std::ranges::sort(sorted_entities,
+                      [&registry](const entt::entity a, const entt::entity b) {
+                          return registry.get<Components::RenderOrder>(a).layer < registry.get<Components::RenderOrder>(b).layer;
+                      }
+    );
+}
+
 entt::entity spawn_background(
     entt::registry& registry,
     AssetManager& asset_manager,
@@ -445,16 +505,17 @@ entt::entity spawn_background(
 entt::entity spawn_bullet(
     entt::registry& registry,
     AssetManager& asset_manager,
-    Components::Transform& transform,
+    BulletPool& bullet_pool,
+    const Components::Transform& transform,
     const Components::Physics& physics,
     const Components::Weapon& weapon,
-    const uint32_t affiliation
+    const FactionId affiliation
 ) {
-    const entt::entity bullet = registry.create();
+    // Copied out first, since transform may live in the storage that creating a bullet grows.
+    const raylib::Vector2 position = transform.position;
+    const float rotation = transform.rotation;
 
-    registry.emplace<Components::Affiliation>(bullet, affiliation);
-
-    const float rotation_rad = transform.rotation * DEG2RAD;
+    const float rotation_rad = rotation * DEG2RAD;
     const raylib::Vector2 direction = {
         std::sin(rotation_rad),
         -std::cos(rotation_rad)
@@ -462,22 +523,48 @@ entt::entity spawn_bullet(
 
     const raylib::Vector2 bullet_velocity = physics.velocity + (direction * weapon.shot_speed);
 
-    Components::Physics bullet_physics = {weapon.shot_speed, 2'000'000, bullet_velocity};
+    const Components::Physics bullet_physics = {weapon.shot_speed, 2'000'000, bullet_velocity};
+    const Components::Transform bullet_transform = {position, raylib::Vector2{5.0f, 5.0f}, rotation};
+
+    // Reviving a parked bullet overwrites its components in place, so only the ShouldNotRender storage changes shape.
+    if (
+        const entt::entity bullet = bullet_pool.acquire(registry);
+        bullet != entt::null
+    ) {
+        registry.get<Components::Affiliation>(bullet).id = affiliation;
+        registry.get<Components::Physics>(bullet) = bullet_physics;
+        registry.get<Components::Transform>(bullet) = bullet_transform;
+        // Otherwise it'd be drawn streaking over from wherever it was parked.
+        registry.get<Components::PreviousTransform>(bullet) = {position, rotation};
+
+        auto& bullet_component = registry.get<Components::Bullet>(bullet);
+        bullet_component.damage = weapon.damage;
+        bullet_component.lifetime = weapon.lifetime;
+        bullet_component.despawn_timer.start(weapon.lifetime);
+        bullet_pool.schedule_expiry(bullet, bullet_component.despawn_timer.get_deadline());
+
+        registry.get<Components::Renderable>(bullet).texture = asset_manager.get_texture(weapon.munition);
+        registry.get<Components::Collider>(bullet) = {weapon.radius, weapon.collision_layer};
+
+        return bullet;
+    }
+
+    const entt::entity bullet = registry.create();
 
+    registry.emplace<Components::Affiliation>(bullet, affiliation);
     registry.emplace<Components::Physics>(bullet, bullet_physics);
-    registry.emplace<Components::Transform>(bullet,
-        transform.position,
-        raylib::Vector2{5.0f, 5.0f},
-        transform.rotation
-    );
+    registry.emplace<Components::Transform>(bullet, bullet_transform);
+    // Parked bullets need one to overwrite, so every bullet gets it from the start.
+    registry.emplace<Components::PreviousTransform>(bullet, position, rotation);
 
     Timer bullet_timer(weapon.lifetime);
     auto& bullet_component = registry.emplace<Components::Bullet>(bullet,
-        50.0f,
+        weapon.damage,
         weapon.lifetime,
         bullet_timer
     );
     bullet_component.despawn_timer.start(weapon.lifetime);
+    bullet_pool.schedule_expiry(bullet, bullet_component.despawn_timer.get_deadline());
 
     auto& renderable = registry.emplace<Components::Renderable>(bullet);
     renderable.texture = asset_manager.get_texture(weapon.munition);
@@ -486,8 +573,7 @@ entt::entity spawn_bullet(
 
     registry.emplace<Components::Collider>(bullet,
         weapon.radius,
-        0b10u,
-        0b1u
+        weapon.collision_layer
     );
 
     return bullet;
@@ -495,38 +581,26 @@ entt::entity spawn_bullet(
 
 entt::entity spawn_engine(
     entt::registry& registry,
-    AssetManager& asset_manager,
-    const std::string& key,
-    raylib::Vector2 relative_offset,
-    entt::entity parent_ship
+    const EnginePrefab& prefab,
+    const entt::entity parent_ship
 ) {
     const auto entity = registry.create();
 
-    // Handle stuff that depends on a found engine
-    if (
-        const auto engine = asset_manager.get_engine(key);
-        !engine
-    ) {
-        H_WARNING("spawn_engine", "Engine not found for: {}, minimal child will be spawned instead", key);
-    } else {
-        registry.emplace<Components::Engine>(entity, (*engine)->thrust);
-
-        auto& renderable = registry.emplace<Components::Renderable>(entity);
-        renderable.color = raylib::Color::White();
-        renderable.texture = asset_manager.get_texture((*engine)->texture);
+    registry.emplace<Components::Engine>(entity, prefab.thrust);
 
-        registry.emplace<Components::RenderOrder>(entity, 999);
+    auto& renderable = registry.emplace<Components::Renderable>(entity);
+    renderable.color = raylib::Color::White();
+    renderable.texture = prefab.texture;
 
-        registry.emplace<Components::ShouldNotRender>(entity);
-    }
+    registry.emplace<Components::RenderOrder>(entity, 999);
 
-    // Do the rest of the stuff that can be done
+    registry.emplace<Components::ShouldNotRender>(entity);
 
     registry.emplace<Components::Transform>(entity,
         raylib::Vector2{0.0, 0.0}
     );
 
-    registry.emplace<Components::RelativeTransform>(entity, relative_offset);
+    registry.emplace<Components::RelativeTransform>(entity, prefab.offset);
 
     registry.emplace<Components::Parent>(entity, parent_ship);
 
@@ -559,27 +633,25 @@ entt::entity spawn_player_ship(
     raylib::Vector2 position
 ) {
     const auto entity = registry.create();
-    auto ship = asset_manager.get_ship(key);
+    const auto ship_id = asset_manager.get_ship_id(key);
 
     registry.emplace<Components::Player>(entity);
 
     registry.emplace<Components::Transform>(entity, position);
 
-    if (!ship) {
-        H_ERROR("spawn_player_ship", "{}", ship.error());
+    if (!ship_id) {
+        H_ERROR("spawn_player_ship", "{}", ship_id.error());
         H_WARNING("spawn_player_ship", "Minimal player ship will be spawned. Please consider resolving this.");
     } else {
+        const ShipPrefab& ship = asset_manager.get_ship_prefab(*ship_id);
+
         // If the ship isn't found, no texture will be found. Thus, don't give the entity a Renderable component.
         auto& renderable = registry.emplace<Components::Renderable>(entity);
-        renderable.texture = asset_manager.get_texture((*ship)->texture);
+        renderable.texture = ship.texture;
 
         registry.emplace<Components::RenderOrder>(entity, 1000);
 
-        registry.emplace<Components::Collider>(entity,
-            (*ship)->radius,
-            0b1u,
-            0b10u
-        );
+        registry.emplace<Components::Collider>(entity, ship.radius, ship.collision_layer);
 
         if (
             auto affiliation_result = asset_manager.get_faction_id("Player");
@@ -591,14 +663,8 @@ entt::entity spawn_player_ship(
         }
 
         // If the ship isn't found, there would be no weapons. Thus, only try spawning them when they might be present.
-        for (const auto& weapon : (*ship)->weapons) {
-            spawn_player_weapon(
-                registry,
-                asset_manager,
-                weapon.weapon_type,
-                raylib::Vector2{weapon.x, weapon.y},
-                entity
-            );
+        for (const auto& weapon : ship.weapons) {
+            spawn_player_weapon(registry, weapon, entity);
         }
 
         // Only do engine stuff when there might be engines.
@@ -606,39 +672,13 @@ entt::entity spawn_player_ship(
 
         // Physics values depend on found data
         auto& ship_physics = registry.emplace<Components::Physics>(entity);
-        ship_physics.max_speed = (*ship)->max_speed;
-
-        std::vector<float> engine_thrusts;
-        std::vector<float> engine_rotations;
-        for (const auto& engine : (*ship)->engines) {
-            spawn_engine(
-                registry,
-                asset_manager,
-                engine.engine_type,
-                raylib::Vector2{engine.x, engine.y},
-                entity
-            );
+        ship_physics.max_speed = ship.max_speed;
+        ship_physics.acceleration = ship.thrust;
+        ship_physics.rotation = ship.rotation;
 
-            if (
-                auto engine_result = asset_manager.get_engine(engine.engine_type);
-                !engine_result
-            ) {
-                H_WARNING("spawn_player_ship", "Couldn't find engine_type: {} while constructing ship: {}", engine.engine_type, key);
-            } else {
-                engine_thrusts.push_back((*engine_result)->thrust);
-                engine_rotations.push_back((*engine_result)->rotation);
-            }
+        for (const auto& engine : ship.engines) {
+            spawn_engine(registry, engine, entity);
         }
-        float thrust_sum = 0.0f;
-        for (const auto& thrust : engine_thrusts) {
-            thrust_sum += thrust;
-        }
-        ship_physics.acceleration = thrust_sum;
-        float rotation_sum = 0.0f;
-        for (const auto& rotation : engine_rotations) {
-            rotation_sum += rotation;
-        }
-        ship_physics.rotation = rotation_sum;
     }
 
     return entity;
@@ -646,12 +686,10 @@ entt::entity spawn_player_ship(
 
 entt::entity spawn_player_weapon(
     entt::registry& registry,
-    AssetManager& asset_manager,
-    const std::string& key,
-    const raylib::Vector2 relative_offset,
+    const WeaponPrefab& prefab,
     const entt::entity parent_ship
 ) {
-    const auto weapon = spawn_weapon(registry, asset_manager, key, relative_offset, parent_ship);
+    const auto weapon = spawn_weapon(registry, prefab, parent_ship);
     registry.emplace<Components::PlayerWeapon>(weapon);
     return weapon;
 }
@@ -661,63 +699,73 @@ entt::entity spawn_ship(
     AssetManager& asset_manager,
     const std::string& key,
     raylib::Vector2 position,
-    uint32_t affiliation
+    FactionId affiliation
 ) {
-    const entt::entity entity = registry.create();
-    auto ship = asset_manager.get_ship(key);
-
-    registry.emplace<Components::Transform>(entity, position);
-
-    registry.emplace<Components::Physics>(entity);
+    const auto ship_id = asset_manager.get_ship_id(key);
 
-    if (!ship) {
-        H_ERROR("spawn_ship", "{}", ship.error());
+    if (!ship_id) {
+        H_ERROR("spawn_ship", "{}", ship_id.error());
         H_WARNING("spawn_ship", "Minimal ship entity will be spawned.");
-    } else {
-        // If the ship can't be found, there will be no texture found, and thus a renderable is useless
-        auto& renderable = registry.emplace<Components::Renderable>(entity);
-        renderable.texture = asset_manager.get_texture((*ship)->texture);
-
-        registry.emplace<Components::RenderOrder>(entity, 0);
-
-        registry.emplace<Components::Collider>(entity,
-            (*ship)->radius,
-            0b1u,
-            0b10u
-        );
-
-        registry.emplace<Components::Affiliation>(entity, affiliation);
 
-        auto& hull = registry.emplace<Components::HullHealth>(entity);
-        hull.hull_front = 400.0f;
-        hull.hull_right = 400.0f;
-        hull.hull_back  = 400.0f;
-        hull.hull_left  = 400.0f;
+        const entt::entity entity = registry.create();
+        registry.emplace<Components::Transform>(entity, position);
+        registry.emplace<Components::Physics>(entity);
+        return entity;
+    }
 
-        // If the ship can't be found, there will be no engines found, and thus it doesn't need to bloat engine processing.
-        registry.emplace<Components::Thrusting>(entity, false);
+    entt::entity entity = entt::null;
+    spawn_ships(registry, asset_manager.get_ship_prefab(*ship_id), std::span{&position, 1}, affiliation, std::span{&entity, 1});
+    return entity;
+}
 
-        // If the ship can't be found, there will be no weapons found, and thus engines shouldn't try to spawn unless the ship is present.
-        for (const auto& weapon : (*ship)->weapons) {
-            spawn_weapon(
-                registry,
-                asset_manager,
-                weapon.weapon_type,
-                raylib::Vector2{weapon.x, weapon.y},
-                entity
-            );
-        }
+void spawn_ships(
+    entt::registry& registry,
+    const ShipPrefab& prefab,
+    const std::span<const raylib::Vector2> positions,
+    const FactionId affiliation,
+    const std::span<entt::entity> ships
+) {
+    const std::size_t count = positions.size();
+    registry.create(ships.begin(), ships.end());
+
+    std::vector<Components::Transform> transforms(count);
+    std::vector<Components::Parent> parents(count);
+    for (std::size_t i = 0; i < count; i++) {
+        transforms[i].position = positions[i];
+        parents[i].parent = ships[i];
     }
 
-    return entity;
+    Components::Renderable renderable;
+    renderable.texture = prefab.texture;
+
+    registry.insert<Components::Transform>(ships.begin(), ships.end(), transforms.begin());
+    registry.insert<Components::Physics>(ships.begin(), ships.end());
+    registry.insert<Components::Renderable>(ships.begin(), ships.end(), renderable);
+    registry.insert<Components::RenderOrder>(ships.begin(), ships.end(), Components::RenderOrder{0});
+    registry.insert<Components::Collider>(ships.begin(), ships.end(), Components::Collider{prefab.radius, prefab.collision_layer});
+    registry.insert<Components::Affiliation>(ships.begin(), ships.end(), Components::Affiliation{affiliation});
+    registry.insert<Components::HullHealth>(ships.begin(), ships.end(), Components::HullHealth{400.0f, 400.0f, 400.0f, 400.0f});
+    registry.insert<Components::Thrusting>(ships.begin(), ships.end(), Components::Thrusting{false});
+
+    // One weapon mount at a time, for every ship at once.
+    std::vector<entt::entity> children(count);
+    for (const auto& weapon_prefab : prefab.weapons) {
+        registry.create(children.begin(), children.end());
+
+        Components::Weapon weapon(weapon_prefab);
+        weapon.trigger_cooldown();
+
+        registry.insert<Components::Transform>(children.begin(), children.end());
+        registry.insert<Components::RelativeTransform>(children.begin(), children.end(), Components::RelativeTransform{weapon_prefab.offset});
+        registry.insert<Components::Parent>(children.begin(), children.end(), parents.begin());
+        registry.insert<Components::Weapon>(children.begin(), children.end(), weapon);
+    }
 }
 
 entt::entity spawn_weapon(
     entt::registry& registry,
-    AssetManager& asset_manager,
-    const std::string& key,
-    raylib::Vector2 relative_offset,
-    entt::entity parent_ship
+    const WeaponPrefab& prefab,
+    const entt::entity parent_ship
 ) {
     const auto weapon_entity = registry.create();
 
@@ -726,20 +774,38 @@ entt::entity spawn_weapon(
     );
 
     registry.emplace<Components::RelativeTransform>(weapon_entity,
-        relative_offset
+        prefab.offset
     );
 
     registry.emplace<Components::Parent>(weapon_entity, parent_ship);
 
-    auto& weapon_component = registry.emplace<Components::Weapon>(weapon_entity,
-        key,
-        asset_manager
-    );
+    auto& weapon_component = registry.emplace<Components::Weapon>(weapon_entity, prefab);
     weapon_component.trigger_cooldown();
 
     return weapon_entity;
 }
 
+void store_previous_transforms(
+    entt::registry& registry,
+    std::pmr::memory_resource& frame_memory
+) {
+    for (auto [entity, transform, previous] : registry.view<Components::Transform, Components::PreviousTransform>().each()) {
+        previous.position = transform.position;
+        previous.rotation = transform.rotation;
+    }
+
+    // Emplacing while iterating would invalidate the view, so new entities are collected first.
+    std::pmr::vector<entt::entity> new_entities(&frame_memory);
+    for (const auto entity : registry.view<Components::Transform>(entt::exclude<Components::PreviousTransform>)) {
+        new_entities.push_back(entity);
+    }
+
+    for (const auto entity : new_entities) {
+        const auto& transform = registry.get<Components::Transform>(entity);
+        registry.emplace<Components::PreviousTransform>(entity, transform.position, transform.rotation);
+    }
+}
+
 void update_animations(
     entt::registry &registry,
     AssetManager &asset_manager,
@@ -784,51 +850,31 @@ void update_background_position(entt::registry& registry) {
     }
 }
 
-void update_bullet_timers(
-    entt::registry& registry,
-    const float dt
-) {
-    for (
-        const auto view = registry.view<Components::Bullet>();
-        const auto entity : view
-    ) {
-        auto& bullet = view.get<Components::Bullet>(entity);
-
-        bullet.despawn_timer.update(dt);
-    }
-}
-
 void update_collision(
     entt::registry& registry,
-    entt::dispatcher& dispatcher
+    entt::dispatcher& dispatcher,
+    CollisionWorld& collision_world
 ) {
-    const auto view = registry.view<Components::Transform, Components::Collider>();
-
-    for (auto it_a = view.begin(); it_a != view.end(); ++it_a) {
-        const auto entity_a = *it_a;
-        const auto& transform_a = view.get<Components::Transform>(entity_a);
-        const auto& collider_a  = view.get<Components::Collider>(entity_a);
-
-        for (auto it_b = std::next(it_a); it_b != view.end(); ++it_b) {
-            const auto entity_b = *it_b;
-            const auto& transform_b = view.get<Components::Transform>(entity_b);
-            const auto& collider_b  = view.get<Components::Collider>(entity_b);
+    collision_world.update(registry);
 
-            if (
-                !((collider_a.collides_with & collider_b.category) ||
-                    (collider_b.collides_with & collider_a.category))
-            ) {
-                continue;
-            }
+    const auto& contacts = collision_world.get_contacts();
 
-            const raylib::Vector2 delta = transform_b.position - transform_a.position;
+    // Only queue up what someone listens for. Persist events especially pile up while things rest against each other.
+    if (!dispatcher.sink<Events::CollisionBegin>().empty()) {
+        for (const auto& collision : contacts.get_began()) {
+            dispatcher.enqueue<Events::CollisionBegin>(collision.a, collision.b);
+        }
+    }
 
-            const float dist_sq = delta.x * delta.x + delta.y * delta.y;
-            const float radius_sum = collider_a.radius + collider_b.radius;
+    if (!dispatcher.sink<Events::CollisionPersist>().empty()) {
+        for (const auto& collision : contacts.get_persisted()) {
+            dispatcher.enqueue<Events::CollisionPersist>(collision.a, collision.b);
+        }
+    }
 
-            if (dist_sq <= radius_sum * radius_sum) {
-                dispatcher.enqueue<Events::Collision>(entity_a, entity_b);
-            }
+    if (!dispatcher.sink<Events::CollisionEnd>().empty()) {
+        for (const auto& collision : contacts.get_ended()) {
+            dispatcher.enqueue<Events::CollisionEnd>(collision.a, collision.b);
         }
     }
 }
@@ -857,17 +903,3 @@ void update_physics_transforms(
         transform.position += physics.velocity * dt;
     });
 }
-
-void update_weapon_timers(
-    entt::registry& registry,
-    const float dt
-) {
-    for (
-        const auto view = registry.view<Components::Weapon>();
-        auto& entity : view
-    ) {
-        auto& weapon = view.get<Components::Weapon>(entity);
-
-        weapon.fire_timer.update(dt);
-    }
-}
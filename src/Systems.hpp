@@ -2,19 +2,30 @@
 
 #pragma once
 
+#include <memory_resource>
+#include <span>
+#include <vector>
+
 #include <entt/entt.hpp>
 
 #include "AssetManager.hpp"
+#include "BulletPool.hpp"
+#include "CollisionResolver.hpp"
+#include "CollisionWorld.hpp"
 #include "Components.hpp"
 #include "Events.hpp"
+#include "Profiler.hpp"
+#include "ProjectileManager.hpp"
 
 void camera_to_player(
     entt::registry& registry,
-    raylib::Camera2D& camera
+    raylib::Camera2D& camera,
+    float alpha
 );
 
 void despawn_entities(
-    entt::registry& registry
+    entt::registry& registry,
+    std::pmr::memory_resource& frame_memory
 );
 
 void engine_visibility(
@@ -34,18 +45,16 @@ void load_start(
 );
 
 void mark_bullets_for_despawn(
-    entt::registry& registry
-);
-
-void on_collision(
     entt::registry& registry,
-    const AssetManager& asset_manager,
-    const Events::Collision& event
+    BulletPool& bullet_pool
 );
 
+// With projectiles set, shots go there instead of becoming bullet entities.
 void player_movement(
     entt::registry& registry,
     AssetManager& asset_manager,
+    BulletPool& bullet_pool,
+    ProjectileManager* projectiles,
     float dt
 );
 
@@ -73,8 +82,28 @@ void print_weapon(
     const std::string& weapon
 );
 
+// Draws in screen space, so call it outside of the camera.
+void render_profiler_overlay(
+    const Profiler& profiler
+);
+
 void render_sprites(
-    entt::registry& registry
+    entt::registry& registry,
+    float alpha,
+    std::pmr::memory_resource& frame_memory
+);
+
+void resolve_collisions(
+    entt::registry& registry,
+    const AssetManager& asset_manager,
+    CollisionResolver& collision_resolver,
+    BulletPool& bullet_pool
+);
+
+// Every entity render_sprites would draw, in drawing order. Kept apart from the drawing so it can be timed without a window.
+void sort_sprites(
+    entt::registry& registry,
+    std::pmr::vector<entt::entity>& sorted_entities
 );
 
 entt::entity spawn_background(
@@ -84,20 +113,20 @@ entt::entity spawn_background(
     int layer
 );
 
+// Reuses a parked bullet from bullet_pool when there is one.
 entt::entity spawn_bullet(
     entt::registry& registry,
     AssetManager& asset_manager,
-    Components::Transform& transform,
+    BulletPool& bullet_pool,
+    const Components::Transform& transform,
     const Components::Physics& physics,
     const Components::Weapon& weapon,
-    uint32_t affiliation
+    FactionId affiliation
 );
 
 entt::entity spawn_engine(
     entt::registry& registry,
-    AssetManager& asset_manager,
-    const std::string& key,
-    raylib::Vector2 relative_offset,
+    const EnginePrefab& prefab,
     entt::entity parent_ship
 );
 
@@ -118,9 +147,7 @@ entt::entity spawn_player_ship(
 
 entt::entity spawn_player_weapon(
     entt::registry& registry,
-    AssetManager& asset_manager,
-    const std::string& key,
-    raylib::Vector2 relative_offset,
+    const WeaponPrefab& prefab,
     entt::entity parent_ship
 );
 
@@ -129,17 +156,30 @@ entt::entity spawn_ship(
     AssetManager& asset_manager,
     const std::string& key,
     raylib::Vector2 position,
-    uint32_t affiliation
+    FactionId affiliation
+);
+
+// Spawns a ship at each of positions, all sharing one affiliation, and writes them to ships, which must be just as long.
+// Each component is added to every ship in one go, so this is the way to spawn a lot of the same ship.
+void spawn_ships(
+    entt::registry& registry,
+    const ShipPrefab& prefab,
+    std::span<const raylib::Vector2> positions,
+    FactionId affiliation,
+    std::span<entt::entity> ships
 );
 
 entt::entity spawn_weapon(
     entt::registry& registry,
-    AssetManager& asset_manager,
-    const std::string& key,
-    raylib::Vector2 relative_offset,
+    const WeaponPrefab& prefab,
     entt::entity parent_ship
 );
 
+void store_previous_transforms(
+    entt::registry& registry,
+    std::pmr::memory_resource& frame_memory
+);
+
 void update_animations(
     entt::registry& registry,
     AssetManager& asset_manager,
@@ -150,14 +190,10 @@ void update_background_position(
     entt::registry& registry
 );
 
-void update_bullet_timers(
-    entt::registry& registry,
-    float dt
-);
-
 void update_collision(
     entt::registry& registry,
-    entt::dispatcher& dispatcher
+    entt::dispatcher& dispatcher,
+    CollisionWorld& collision_world
 );
 
 void update_local_transforms(
@@ -168,8 +204,3 @@ void update_physics_transforms(
     entt::registry& registry,
     float dt
 );
-
-void update_weapon_timers(
-    entt::registry& registry,
-    float dt
-);
@@ -0,0 +1,108 @@
+// Copyright 2025 RestingImmortal
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+#include "AllocationTracker.hpp"
+
+// Public Methods
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_workers.reserve(thread_count - 1);
+    for (std::size_t i = 1; i < thread_count; i++) {
+        m_workers.emplace_back([this] { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::scoped_lock lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    // Join here rather than leaving it to member destruction, since the workers still need the mutex on their way out.
+    m_workers.clear();
+}
+
+std::size_t ThreadPool::get_thread_count() const {
+    return m_workers.size() + 1;
+}
+
+// Private Methods
+
+void ThreadPool::run_erased(const std::size_t task_count, const TaskFunction task, void* context) {
+    if (m_workers.empty() || task_count <= 1) {
+        for (std::size_t index = 0; index < task_count; index++) {
+            task(context, index);
+        }
+        return;
+    }
+
+    {
+        std::scoped_lock lock(m_mutex);
+        m_task = task;
+        m_task_context = context;
+        m_task_count = task_count;
+        m_task_scope = AllocationTracker::current();
+        m_next_task.store(0, std::memory_order_relaxed);
+        m_busy_workers = m_workers.size();
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    drain(task, context, task_count);
+
+    std::unique_lock lock(m_mutex);
+    m_finished.wait(lock, [this] { return m_busy_workers == 0; });
+    m_task = nullptr;
+    m_task_context = nullptr;
+}
+
+void ThreadPool::worker_loop() {
+    uint64_t seen_generation = 0;
+
+    while (true) {
+        TaskFunction task;
+        void* context;
+        std::size_t task_count;
+        uint32_t scope;
+        {
+            std::unique_lock lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seen_generation; });
+            if (m_stopping) {
+                return;
+            }
+            seen_generation = m_generation;
+            task = m_task;
+            context = m_task_context;
+            task_count = m_task_count;
+            scope = m_task_scope;
+        }
+
+        const uint32_t previous_scope = AllocationTracker::enter(scope);
+        drain(task, context, task_count);
+        AllocationTracker::enter(previous_scope);
+
+        {
+            std::scoped_lock lock(m_mutex);
+            m_busy_workers--;
+        }
+        m_finished.notify_one();
+    }
+}
+
+void ThreadPool::drain(const TaskFunction task, void* context, const std::size_t task_count) {
+    for (
+        std::size_t index = m_next_task.fetch_add(1, std::memory_order_relaxed);
+        index < task_count;
+        index = m_next_task.fetch_add(1, std::memory_order_relaxed)
+    ) {
+        task(context, index);
+    }
+}
@@ -0,0 +1,66 @@
+// Copyright 2025 RestingImmortal
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads for splitting a batch of tasks across cores.
+// The calling thread pitches in too, so a pool of one thread just runs everything inline.
+class ThreadPool {
+public:
+    // A thread count of 0 means one thread per hardware core.
+    explicit ThreadPool(std::size_t thread_count);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Calls task(index) for every index in [0, task_count), and only returns once all of them have finished.
+    // Tasks can run in any order and on any thread, so anything order dependent belongs to the caller.
+    // Whatever they allocate counts towards the caller's AllocationTracker scope.
+    template <typename Task>
+    void run(const std::size_t task_count, Task&& task) {
+        // Type erased by hand rather than through std::function, so a per-frame call doesn't allocate.
+        run_erased(
+            task_count,
+            [](void* context, const std::size_t index) { (*static_cast<std::remove_reference_t<Task>*>(context))(index); },
+            const_cast<void*>(static_cast<const void*>(std::addressof(task)))
+        );
+    }
+
+    // Total threads doing work during run, including the caller.
+    [[nodiscard]]
+    std::size_t get_thread_count() const;
+
+private:
+    using TaskFunction = void (*)(void* context, std::size_t index);
+
+    std::vector<std::jthread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_finished;
+
+    TaskFunction m_task = nullptr;
+    void* m_task_context = nullptr;
+    std::size_t m_task_count = 0;
+    uint32_t m_task_scope = 0;
+    std::atomic<std::size_t> m_next_task = 0;
+    std::size_t m_busy_workers = 0;
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+
+    void run_erased(std::size_t task_count, TaskFunction task, void* context);
+
+    void worker_loop();
+
+    void drain(TaskFunction task, void* context, std::size_t task_count);
+};
@@ -4,8 +4,10 @@
 
 #include <algorithm>
 
+#include "SimClock.hpp"
+
 void Timer::start() {
-    m_elapsed = 0;
+    m_deadline = SimClock::now() + m_duration;
     m_active = true;
 }
 
@@ -14,13 +16,10 @@ void Timer::start(const float new_duration) {
     start();
 }
 
-void Timer::update(const float delta) {
-    if (!m_active) return;
-    m_elapsed += delta;
-}
+void Timer::update(float) {}
 
 bool Timer::is_done() const {
-    return m_active && (m_elapsed >= m_duration);
+    return m_active && SimClock::now() >= m_deadline;
 }
 
 void Timer::stop() {
@@ -35,9 +34,17 @@ float Timer::get_progress() const {
     if (m_duration <= 0.0f) {
         return m_active ? 1.0f : 0.0f;
     }
-    return std::clamp(m_elapsed / m_duration, 0.0f, 1.0f);
+    if (!m_active) {
+        return 0.0f;
+    }
+    const auto remaining = static_cast<float>(m_deadline - SimClock::now());
+    return std::clamp(1.0f - remaining / m_duration, 0.0f, 1.0f);
 }
 
 float Timer::get_duration() const {
     return m_duration;
 }
+
+double Timer::get_deadline() const {
+    return m_deadline;
+}
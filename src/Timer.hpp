@@ -2,6 +2,8 @@
 
 #pragma once
 
+// Counts down against the SimClock. Starting one just records when it'll be done, so nothing has to touch it
+// every tick while it runs.
 class Timer {
 public:
     Timer() : m_duration(0.0f) {}
@@ -11,6 +13,7 @@ public:
 
     void start(float new_duration);
 
+    // Nothing to do, as time comes from the SimClock. Still here so callers written for ticked timers keep working.
     void update(float delta);
 
     bool is_done() const;
@@ -23,8 +26,11 @@ public:
 
     float get_duration() const;
 
+    // SimClock time at which the timer is done. Only means anything while it's active.
+    double get_deadline() const;
+
 private:
-    float m_duration;
-    float m_elapsed = 0;
-    bool  m_active = false;
+    float  m_duration;
+    double m_deadline = 0.0;
+    bool   m_active = false;
 };
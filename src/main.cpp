@@ -14,10 +14,17 @@ int main() {
     const ConfigManager configs;
 
     Logger::set_level(configs.log_level);
+    Logger::set_rate_limit(configs.log_rate_limit);
     Logger::get().add_sink(std::make_unique<ConsoleSink>());
+    if (configs.async_logging) {
+        Logger::get().start_async(configs.log_queue_size);
+    }
+    if (!configs.binary_log.empty() && !Logger::get().start_binary(configs.binary_log)) {
+        H_WARNING("main", "Couldn't open binary log {}", configs.binary_log);
+    }
 
     // Game
-    Game game(800, 600, configs.title);
+    Game game(800, 600, configs);
     game.run();
 
     // Exiting
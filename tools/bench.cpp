@@ -0,0 +1,438 @@
+// Copyright 2025 RestingImmortal
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory_resource>
+#include <functional>
+#include <print>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <nlohmann/json.hpp>
+#include <raylib-cpp.hpp>
+
+#include "AssetManager.hpp"
+#include "BulletPool.hpp"
+#include "CollisionWorld.hpp"
+#include "Components.hpp"
+#include "FrameArena.hpp"
+#include "Logger.hpp"
+#include "SimClock.hpp"
+#include "Systems.hpp"
+#include "ThreadPool.hpp"
+
+using json = nlohmann::json;
+
+// Times every system on its own against synthetic registries, and writes the results as JSON.
+// Usage: horizons_bench [--help] [--out file] [--sizes 1000,10000,100000] [--weapons-per-ship n]
+//                       [--engines-per-ship n] [--bullets-per-ship n] [--threads n] [--broadphase name]
+namespace {
+    // Each repeated measurement keeps going until it has at least this much time, to smooth out noise.
+    constexpr auto k_min_measure_time = std::chrono::milliseconds(200);
+    constexpr std::size_t k_min_iterations = 5;
+    constexpr std::size_t k_max_iterations = 1000;
+
+    // Systems that tear down what they run on get a fresh world per run, so they get fewer of them.
+    constexpr int k_destructive_runs = 5;
+
+    constexpr float k_ship_spacing = 200.0f;
+    constexpr float k_tick = 1.0f / 60.0f;
+
+    struct Options {
+        std::string out = "bench.json";
+        std::vector<std::size_t> sizes = {1'000, 10'000, 100'000};
+        std::size_t weapons_per_ship = 2;
+        std::size_t engines_per_ship = 1;
+        std::size_t bullets_per_ship = 4;
+        std::size_t threads = 0;
+        BroadphaseMode broadphase = BroadphaseMode::SpatialHash;
+        bool help = false;
+    };
+
+    // One synthetic level. Ships are spread over a square that grows with the count, so density stays the same across sizes.
+    struct World {
+        entt::registry registry;
+        entt::dispatcher dispatcher;
+        AssetManager asset_manager; // Never loaded, so get_texture hands out empty textures.
+        std::vector<entt::entity> ships;
+        std::vector<entt::entity> bullets;
+        FrameArena frame_arena;
+        BulletPool bullet_pool{SIZE_MAX};
+        std::pmr::vector<entt::entity> scratch;
+    };
+
+    struct Result {
+        std::string system;
+        std::size_t size;
+        std::size_t entities;
+        int iterations;
+        double median_ns;
+    };
+
+    bool parse_count(const std::string_view text, std::size_t& out) {
+        const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return ec == std::errc{} && ptr == text.data() + text.size();
+    }
+
+    bool parse_options(const int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string_view flag = argv[i];
+            if (flag == "--help" || flag == "-h") {
+                options.help = true;
+                return true;
+            }
+            if (i + 1 >= argc) {
+                return false;
+            }
+            const std::string_view value = argv[++i];
+
+            if (flag == "--out") {
+                options.out = value;
+            } else if (flag == "--sizes") {
+                options.sizes.clear();
+                for (const auto part : std::views::split(value, ',')) {
+                    std::size_t size = 0;
+                    if (!parse_count(std::string_view(part.begin(), part.end()), size) || size == 0) {
+                        return false;
+                    }
+                    options.sizes.push_back(size);
+                }
+            } else if (flag == "--weapons-per-ship") {
+                if (!parse_count(value, options.weapons_per_ship)) return false;
+            } else if (flag == "--engines-per-ship") {
+                if (!parse_count(value, options.engines_per_ship)) return false;
+            } else if (flag == "--bullets-per-ship") {
+                if (!parse_count(value, options.bullets_per_ship)) return false;
+            } else if (flag == "--threads") {
+                if (!parse_count(value, options.threads)) return false;
+            } else if (flag == "--broadphase") {
+                if (value == "spatial_hash")         options.broadphase = BroadphaseMode::SpatialHash;
+                else if (value == "sweep_and_prune") options.broadphase = BroadphaseMode::SweepAndPrune;
+                else if (value == "brute_force")     options.broadphase = BroadphaseMode::BruteForce;
+                else return false;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string_view broadphase_name(const BroadphaseMode mode) {
+        switch (mode) {
+            case BroadphaseMode::BruteForce:    return "brute_force";
+            case BroadphaseMode::SpatialHash:   return "spatial_hash";
+            case BroadphaseMode::SweepAndPrune: return "sweep_and_prune";
+        }
+        return "unknown";
+    }
+
+    CollisionLayers make_layers() {
+        CollisionLayers layers;
+        layers.names = {"Ship", "Bullet"};
+        layers.masks[0] = 0b10;
+        layers.masks[1] = 0b01;
+        return layers;
+    }
+
+    Components::Weapon make_weapon() {
+        Components::Weapon weapon;
+        weapon.damage = 10.0f;
+        weapon.lifetime = 1'000.0f;
+        weapon.radius = 3.0f;
+        weapon.shot_speed = 400.0f;
+        weapon.collision_layer = 1;
+        return weapon;
+    }
+
+    // Rounds down to whole ships, so the real entity count can come in a little under the size asked for.
+    // Returns how many entities were actually made.
+    std::size_t build_world(World& world, const Options& options, const std::size_t size) {
+        const std::size_t per_ship = 1 + options.weapons_per_ship + options.engines_per_ship + options.bullets_per_ship;
+        const std::size_t ship_count = std::max<std::size_t>(size / per_ship, 1);
+        const float extent = std::sqrt(static_cast<float>(ship_count)) * k_ship_spacing;
+
+        std::mt19937 rng(static_cast<uint32_t>(size));
+        std::uniform_real_distribution<float> position(0.0f, extent);
+        std::uniform_real_distribution<float> velocity(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> rotation(0.0f, 360.0f);
+
+        auto& registry = world.registry;
+        const auto weapon = make_weapon();
+
+        for (std::size_t i = 0; i < ship_count; i++) {
+            const auto ship = registry.create();
+            const FactionId faction{static_cast<uint32_t>(i % 2)};
+
+            registry.emplace<Components::Transform>(ship, raylib::Vector2{position(rng), position(rng)}, raylib::Vector2{1, 1}, rotation(rng));
+            registry.emplace<Components::Physics>(ship, 20.0f, 400.0f, raylib::Vector2{velocity(rng), velocity(rng)}, 180.0f);
+            registry.emplace<Components::Renderable>(ship);
+            registry.emplace<Components::RenderOrder>(ship, 100);
+            registry.emplace<Components::Collider>(ship, 20.0f, 0u);
+            registry.emplace<Components::Affiliation>(ship, faction);
+            registry.emplace<Components::HullHealth>(ship);
+            registry.emplace<Components::Thrusting>(ship, i % 3 == 0);
+            world.ships.push_back(ship);
+
+            for (std::size_t w = 0; w < options.weapons_per_ship; w++) {
+                const auto child = registry.create();
+                registry.emplace<Components::Transform>(child);
+                registry.emplace<Components::RelativeTransform>(child, raylib::Vector2{static_cast<float>(w) * 4.0f - 4.0f, -10.0f});
+                registry.emplace<Components::Parent>(child, ship);
+                registry.emplace<Components::Weapon>(child, weapon);
+            }
+
+            for (std::size_t e = 0; e < options.engines_per_ship; e++) {
+                const auto child = registry.create();
+                registry.emplace<Components::Engine>(child);
+                registry.emplace<Components::Renderable>(child);
+                registry.emplace<Components::RenderOrder>(child, 999);
+                registry.emplace<Components::ShouldNotRender>(child);
+                registry.emplace<Components::Transform>(child);
+                registry.emplace<Components::RelativeTransform>(child, raylib::Vector2{static_cast<float>(e) * 4.0f, 12.0f});
+                registry.emplace<Components::Parent>(child, ship);
+            }
+
+            for (std::size_t b = 0; b < options.bullets_per_ship; b++) {
+                auto transform = Components::Transform{raylib::Vector2{position(rng), position(rng)}, raylib::Vector2{5, 5}, rotation(rng)};
+                const Components::Physics physics = {20.0f, 400.0f, raylib::Vector2{velocity(rng), velocity(rng)}, 180.0f};
+                world.bullets.push_back(spawn_bullet(registry, world.asset_manager, world.bullet_pool, transform, physics, weapon, FactionId{1 - faction.index}));
+            }
+        }
+
+        return ship_count * per_ship;
+    }
+
+    // Runs system over and over on one world and reports the median run.
+    Result measure(
+        const std::string_view name,
+        const Options& options,
+        const std::size_t size,
+        const std::function<void(World&)>& system
+    ) {
+        World world;
+        const std::size_t entities = build_world(world, options, size);
+
+        // Once to warm caches and grow any buffers the system keeps around.
+        system(world);
+
+        std::vector<double> samples;
+        const auto deadline = std::chrono::steady_clock::now() + k_min_measure_time;
+        while (
+            samples.size() < k_max_iterations &&
+            (samples.size() < k_min_iterations || std::chrono::steady_clock::now() < deadline)
+        ) {
+            const auto start = std::chrono::steady_clock::now();
+            system(world);
+            samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        std::ranges::nth_element(samples, samples.begin() + samples.size() / 2);
+        return {std::string(name), size, entities, static_cast<int>(samples.size()), samples[samples.size() / 2]};
+    }
+
+    // For systems that destroy or create entities. Setup isn't timed, and count says how many entities a run dealt with.
+    Result measure_destructive(
+        const std::string_view name,
+        const Options& options,
+        const std::size_t size,
+        const std::function<void(World&)>& setup,
+        const std::function<std::size_t(World&)>& system
+    ) {
+        std::vector<double> samples;
+        std::size_t entities = 0;
+
+        for (int run = 0; run < k_destructive_runs; run++) {
+            World world;
+            build_world(world, options, size);
+            setup(world);
+
+            const auto start = std::chrono::steady_clock::now();
+            entities = system(world);
+            samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        std::ranges::nth_element(samples, samples.begin() + samples.size() / 2);
+        return {std::string(name), size, entities, static_cast<int>(samples.size()), samples[samples.size() / 2]};
+    }
+
+    std::vector<Result> run_size(const Options& options, ThreadPool& thread_pool, const std::size_t size) {
+        std::vector<Result> results;
+
+        results.push_back(measure("store_previous_transforms", options, size, [](World& world) {
+            world.frame_arena.reset();
+            store_previous_transforms(world.registry, world.frame_arena.get_resource());
+        }));
+        results.push_back(measure("update_physics_transforms", options, size, [](World& world) {
+            update_physics_transforms(world.registry, k_tick);
+        }));
+        results.push_back(measure("update_local_transforms", options, size, [](World& world) {
+            update_local_transforms(world.registry);
+        }));
+        results.push_back(measure("engine_visibility", options, size, [](World& world) {
+            engine_visibility(world.registry);
+        }));
+        results.push_back(measure("sort_sprites", options, size, [](World& world) {
+            sort_sprites(world.registry, world.scratch);
+        }));
+
+        // The collision world keeps buffers and contacts between ticks, so it has to outlive the runs like it does in game.
+        CollisionWorld collision_world(options.broadphase, &thread_pool);
+        collision_world.set_layers(make_layers());
+        results.push_back(measure("update_collision", options, size, [&collision_world](World& world) {
+            update_collision(world.registry, world.dispatcher, collision_world);
+        }));
+
+        results.push_back(measure_destructive("despawn_entities", options, size,
+            [](World& world) {
+                world.registry.insert<Components::DespawnMarker>(world.bullets.begin(), world.bullets.end());
+            },
+            [](World& world) {
+                despawn_entities(world.registry, world.frame_arena.get_resource());
+                return world.bullets.size();
+            }
+        ));
+
+        // Every bullet expires at once, as the clock is moved past all of their despawn timers first.
+        results.push_back(measure_destructive("mark_bullets_for_despawn", options, size,
+            [](World&) {
+                SimClock::advance(make_weapon().lifetime + k_tick);
+            },
+            [](World& world) {
+                mark_bullets_for_despawn(world.registry, world.bullet_pool);
+                return world.bullets.size();
+            }
+        ));
+
+        results.push_back(measure_destructive("spawn_bullet", options, size,
+            [](World&) {},
+            [](World& world) {
+                const auto weapon = make_weapon();
+                const Components::Physics physics;
+                for (const auto ship : world.ships) {
+                    spawn_bullet(world.registry, world.asset_manager, world.bullet_pool, world.registry.get<Components::Transform>(ship), physics, weapon, FactionId{0});
+                }
+                return world.ships.size();
+            }
+        ));
+
+        // Same again, but every shot revives a parked bullet instead of creating one.
+        results.push_back(measure_destructive("spawn_bullet_pooled", options, size,
+            [](World& world) {
+                for (const auto bullet : world.bullets) {
+                    world.bullet_pool.release(world.registry, bullet);
+                }
+                // Released bullets sit out a collision pass before they can be reused.
+                for (uint64_t tick = 0; tick < BulletPool::k_min_parked_ticks; tick++) {
+                    SimClock::advance(k_tick);
+                }
+            },
+            [](World& world) {
+                const auto weapon = make_weapon();
+                const Components::Physics physics;
+                for (const auto ship : world.ships) {
+                    spawn_bullet(world.registry, world.asset_manager, world.bullet_pool, world.registry.get<Components::Transform>(ship), physics, weapon, FactionId{0});
+                }
+                return world.ships.size();
+            }
+        ));
+
+        // Map loading: as many ships again as the world already has, all from one prefab.
+        ShipPrefab prefab = {.max_speed = 400.0f, .radius = 20.0f, .collision_layer = 0u, .thrust = 20.0f, .rotation = 180.0f};
+        for (std::size_t w = 0; w < options.weapons_per_ship; w++) {
+            prefab.weapons.push_back({
+                .offset = raylib::Vector2{static_cast<float>(w) * 4.0f - 4.0f, -10.0f},
+                .damage = 10.0f, .lifetime = 1'000.0f, .cooldown = 1.0f, .radius = 3.0f, .collision_layer = 1u
+            });
+        }
+        std::vector<raylib::Vector2> positions;
+        std::vector<entt::entity> spawned;
+        results.push_back(measure_destructive("spawn_ships", options, size,
+            [&positions, &spawned](World& world) {
+                positions.clear();
+                for (const auto ship : world.ships) {
+                    positions.push_back(world.registry.get<Components::Transform>(ship).position);
+                }
+                spawned.assign(positions.size(), entt::null);
+            },
+            [&options, &prefab, &positions, &spawned](World& world) {
+                spawn_ships(world.registry, prefab, positions, FactionId{0}, spawned);
+                return spawned.size() * (1 + options.weapons_per_ship);
+            }
+        ));
+
+        return results;
+    }
+}
+
+int main(const int argc, char** argv) {
+    Options options;
+    const bool parsed = parse_options(argc, argv, options);
+    if (!parsed || options.help) {
+        std::println(
+            "Usage: {} [--out file] [--sizes 1000,10000,100000] [--weapons-per-ship n] "
+            "[--engines-per-ship n] [--bullets-per-ship n] [--threads n] [--broadphase name]\n"
+            "Broadphases are spatial_hash (the default), sweep_and_prune, and brute_force.",
+            argv[0]
+        );
+        return parsed ? 0 : 1;
+    }
+
+    // Library configuration
+    SetTraceLogLevel(LOG_WARNING);
+    Logger::set_level(LogLevel::Warning);
+    Logger::get().add_sink(std::make_unique<ConsoleSink>());
+
+    ThreadPool thread_pool(options.threads);
+
+    json results = json::array();
+    std::println("{:<28} {:>8} {:>9} {:>7} {:>14} {:>12}", "System", "Size", "Entities", "Runs", "Median ns", "ns/entity");
+    for (const auto size : options.sizes) {
+        for (const auto& result : run_size(options, thread_pool, size)) {
+            const double per_entity = result.median_ns / static_cast<double>(std::max<std::size_t>(result.entities, 1));
+            std::println(
+                "{:<28} {:>8} {:>9} {:>7} {:>14.0f} {:>12.2f}",
+                result.system, result.size, result.entities, result.iterations, result.median_ns, per_entity
+            );
+
+            results.push_back({
+                {"system", result.system},
+                {"size", result.size},
+                {"entities", result.entities},
+                {"iterations", result.iterations},
+                {"median_ns", result.median_ns},
+                {"ns_per_entity", per_entity}
+            });
+        }
+    }
+
+    const json report = {
+        {"config", {
+            {"weapons_per_ship", options.weapons_per_ship},
+            {"engines_per_ship", options.engines_per_ship},
+            {"bullets_per_ship", options.bullets_per_ship},
+            {"threads", thread_pool.get_thread_count()},
+            {"broadphase", std::string(broadphase_name(options.broadphase))}
+        }},
+        {"results", results}
+    };
+
+    std::ofstream file(options.out);
+    if (!file) {
+        std::println("Couldn't open {} for writing", options.out);
+        return 1;
+    }
+    file << report.dump(4) << '\n';
+    std::println("Wrote {}", options.out);
+
+    return 0;
+}
@@ -0,0 +1,287 @@
+// Copyright 2025 RestingImmortal
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <print>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <raylib-cpp.hpp>
+
+#include "AssetManager.hpp"
+#include "BulletPool.hpp"
+#include "CollisionWorld.hpp"
+#include "Components.hpp"
+#include "Logger.hpp"
+#include "SimClock.hpp"
+#include "Systems.hpp"
+#include "ThreadPool.hpp"
+
+// Runs the simulation through situations that have gone wrong before, and exits nonzero if any of them do again.
+// Run by ctest, or on its own.
+// Usage: horizons_check
+namespace {
+    constexpr float k_tick = 1.0f / 60.0f;
+
+    // Enough colliders that the collision broadphase gets split over every thread.
+    constexpr std::size_t k_crowd_size = 20'000;
+    constexpr std::size_t k_crowd_threads = 4;
+
+    CollisionLayers make_layers() {
+        CollisionLayers layers;
+        layers.names = {"Ship", "Bullet"};
+        layers.masks[0] = 0b10;
+        layers.masks[1] = 0b01;
+        return layers;
+    }
+
+    Components::Weapon make_weapon() {
+        Components::Weapon weapon;
+        weapon.damage = 10.0f;
+        weapon.lifetime = 1'000.0f;
+        weapon.radius = 3.0f;
+        weapon.shot_speed = 0.0f;
+        weapon.collision_layer = 1;
+        return weapon;
+    }
+
+    bool has_pair(const std::vector<Events::Collision>& collisions, const entt::entity a, const entt::entity b) {
+        for (const auto& collision : collisions) {
+            if ((collision.a == a && collision.b == b) || (collision.a == b && collision.b == a)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // A bullet fired into a ship every tick, and parked again as soon as it hits, has to start a fresh contact each
+    // time, even once it's a revived bullet with an entity id the contact cache has seen before.
+    bool check_revived_bullets_begin_contacts() {
+        entt::registry registry;
+        AssetManager asset_manager; // Never loaded, so get_texture hands out empty textures.
+        BulletPool bullet_pool;
+        CollisionWorld collision_world;
+        collision_world.set_layers(make_layers());
+
+        const auto ship = registry.create();
+        registry.emplace<Components::Transform>(ship, raylib::Vector2{0.0f, 0.0f}, raylib::Vector2{1.0f, 1.0f}, 0.0f);
+        registry.emplace<Components::Collider>(ship, 20.0f, 0u);
+
+        const Components::Transform muzzle = {raylib::Vector2{0.0f, 0.0f}, raylib::Vector2{1.0f, 1.0f}, 0.0f};
+        const Components::Physics physics;
+        const auto weapon = make_weapon();
+
+        for (int tick = 0; tick < 16; tick++) {
+            SimClock::advance(k_tick);
+            const auto bullet = spawn_bullet(registry, asset_manager, bullet_pool, muzzle, physics, weapon, FactionId{1});
+            collision_world.update(registry);
+
+            if (!has_pair(collision_world.get_contacts().get_began(), ship, bullet)) {
+                std::println(
+                    "Tick {}: bullet {} hit ship {} without a CollisionBegin",
+                    tick, entt::to_integral(bullet), entt::to_integral(ship)
+                );
+                return false;
+            }
+
+            bullet_pool.release(registry, bullet);
+        }
+
+        // Otherwise nothing above was ever revived, and it proves nothing.
+        if (bullet_pool.get_stats().hits == 0) {
+            std::println("No bullet was ever reused");
+            return false;
+        }
+        return true;
+    }
+
+    std::string_view broadphase_name(const BroadphaseMode mode) {
+        switch (mode) {
+            case BroadphaseMode::BruteForce:    return "brute_force";
+            case BroadphaseMode::SpatialHash:   return "spatial_hash";
+            case BroadphaseMode::SweepAndPrune: return "sweep_and_prune";
+        }
+        return "unknown";
+    }
+
+    // A crowd of ships and bullets, dense enough that plenty of them overlap, checked a few ticks running by a
+    // CollisionWorld split over a thread pool and one that isn't. Both have to find the same hits in the same order.
+    bool check_parallel_collisions_match_serial() {
+        // Ships hit each other as well as bullets, so both same layer and cross layer passes get split.
+        CollisionLayers layers = make_layers();
+        layers.masks[0] = 0b11;
+
+        ThreadPool thread_pool(k_crowd_threads);
+
+        for (const auto mode : {BroadphaseMode::SpatialHash, BroadphaseMode::SweepAndPrune}) {
+            entt::registry registry;
+            std::mt19937 rng(static_cast<uint32_t>(mode));
+            std::uniform_real_distribution<float> position(0.0f, 4'000.0f);
+            std::uniform_real_distribution<float> step(-10.0f, 10.0f);
+
+            for (std::size_t i = 0; i < k_crowd_size; i++) {
+                const auto entity = registry.create();
+                const bool ship = i % 4 == 0;
+                registry.emplace<Components::Transform>(entity, raylib::Vector2{position(rng), position(rng)}, raylib::Vector2{1.0f, 1.0f}, 0.0f);
+                registry.emplace<Components::Collider>(entity, ship ? 20.0f : 3.0f, ship ? 0u : 1u);
+            }
+
+            CollisionWorld serial(mode);
+            CollisionWorld parallel(mode, &thread_pool, true);
+            serial.set_layers(layers);
+            parallel.set_layers(layers);
+
+            for (int tick = 0; tick < 8; tick++) {
+                serial.update(registry);
+                parallel.update(registry);
+
+                const auto& expected = serial.get_collisions();
+                const auto& actual = parallel.get_collisions();
+                for (std::size_t i = 0; i < std::max(expected.size(), actual.size()); i++) {
+                    const bool differs =
+                        i >= expected.size() || i >= actual.size() ||
+                        expected[i].a != actual[i].a || expected[i].b != actual[i].b;
+                    if (!differs) {
+                        continue;
+                    }
+
+                    std::println(
+                        "{}, tick {}: {} hits in parallel and {} serially. Hit {} differs first: ({}, {}) in parallel, ({}, {}) serially",
+                        broadphase_name(mode), tick, actual.size(), expected.size(), i,
+                        i < actual.size() ? entt::to_integral(actual[i].a) : 0u,
+                        i < actual.size() ? entt::to_integral(actual[i].b) : 0u,
+                        i < expected.size() ? entt::to_integral(expected[i].a) : 0u,
+                        i < expected.size() ? entt::to_integral(expected[i].b) : 0u
+                    );
+                    return false;
+                }
+
+                if (parallel.get_divergences() > 0) {
+                    std::println("{}, tick {}: the parallel world's own check against a serial run failed", broadphase_name(mode), tick);
+                    return false;
+                }
+                if (expected.empty()) {
+                    std::println("{}, tick {}: nothing collided, so nothing was compared", broadphase_name(mode), tick);
+                    return false;
+                }
+
+                for (auto&& [entity, transform] : registry.view<Components::Transform>().each()) {
+                    transform.position.x += step(rng);
+                    transform.position.y += step(rng);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Colliders with a NaN position, one flung far off, and one big enough to cover everything, mixed in with ordinary
+    // ones. Both broadphases have to cope with them and find exactly the hits the every-pair loop does, including on
+    // the tick after a collider goes bad or comes good again, which sweep and prune carries its intervals over.
+    bool check_broadphases_survive_bad_colliders() {
+        entt::registry registry;
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> position(0.0f, 1'000.0f);
+
+        std::vector<entt::entity> ordinary;
+        for (int i = 0; i < 500; i++) {
+            const auto entity = registry.create();
+            ordinary.push_back(entity);
+            registry.emplace<Components::Transform>(entity, raylib::Vector2{position(rng), position(rng)}, raylib::Vector2{1.0f, 1.0f}, 0.0f);
+            registry.emplace<Components::Collider>(entity, 5.0f, static_cast<uint32_t>(i % 2));
+        }
+
+        struct Bad {
+            float x;
+            float y;
+            float radius;
+        };
+        constexpr Bad bad[] = {
+            {std::numeric_limits<float>::quiet_NaN(), 0.0f, 5.0f},
+            {0.0f, std::numeric_limits<float>::quiet_NaN(), 5.0f},
+            {1e30f, -1e30f, 5.0f},
+            {500.0f, 500.0f, 1e6f},
+        };
+        std::vector<entt::entity> bad_entities;
+        for (const auto& [x, y, radius] : bad) {
+            const auto entity = registry.create();
+            bad_entities.push_back(entity);
+            registry.emplace<Components::Transform>(entity, raylib::Vector2{x, y}, raylib::Vector2{1.0f, 1.0f}, 0.0f);
+            registry.emplace<Components::Collider>(entity, radius, 0u);
+        }
+
+        CollisionLayers layers = make_layers();
+        layers.masks[0] = 0b11;
+
+        CollisionWorld brute_force(BroadphaseMode::BruteForce);
+        CollisionWorld spatial_hash(BroadphaseMode::SpatialHash);
+        CollisionWorld sweep_and_prune(BroadphaseMode::SweepAndPrune);
+        for (auto* world : {&brute_force, &spatial_hash, &sweep_and_prune}) {
+            world->set_layers(layers);
+        }
+
+        const auto sorted_hits = [](const CollisionWorld& world) {
+            std::vector<std::pair<uint32_t, uint32_t>> hits;
+            for (const auto& [a, b] : world.get_collisions()) {
+                hits.emplace_back(std::minmax(entt::to_integral(a), entt::to_integral(b)));
+            }
+            std::ranges::sort(hits);
+            return hits;
+        };
+
+        for (int tick = 0; tick < 2; tick++) {
+            for (auto* world : {&brute_force, &spatial_hash, &sweep_and_prune}) {
+                world->update(registry);
+            }
+
+            const auto expected = sorted_hits(brute_force);
+            for (const auto* world : {&spatial_hash, &sweep_and_prune}) {
+                if (const auto actual = sorted_hits(*world); actual != expected) {
+                    std::println(
+                        "{}, tick {}: found {} hits where brute_force found {}",
+                        broadphase_name(world->get_mode()), tick, actual.size(), expected.size()
+                    );
+                    return false;
+                }
+            }
+
+            // The first NaN collider comes good, and an ordinary one goes bad.
+            registry.get<Components::Transform>(bad_entities.front()).position = {500.0f, 500.0f};
+            registry.get<Components::Transform>(ordinary.front()).position.x = std::numeric_limits<float>::quiet_NaN();
+        }
+        return true;
+    }
+}
+
+int main() {
+    // Library configuration
+    SetTraceLogLevel(LOG_WARNING);
+    Logger::set_level(LogLevel::Warning);
+    Logger::get().add_sink(std::make_unique<ConsoleSink>());
+
+    struct Check {
+        std::string_view name;
+        bool (*run)();
+    };
+    constexpr Check checks[] = {
+        {"revived_bullets_begin_contacts", check_revived_bullets_begin_contacts},
+        {"parallel_collisions_match_serial", check_parallel_collisions_match_serial},
+        {"broadphases_survive_bad_colliders", check_broadphases_survive_bad_colliders},
+    };
+
+    int failed = 0;
+    for (const auto& check : checks) {
+        SimClock::reset();
+        const bool passed = check.run();
+        std::println("{:<36} {}", check.name, passed ? "ok" : "FAILED");
+        failed += passed ? 0 : 1;
+    }
+
+    return failed == 0 ? 0 : 1;
+}
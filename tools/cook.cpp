@@ -0,0 +1,39 @@
+// Copyright 2025 RestingImmortal
+
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <print>
+
+#include <raylib-cpp.hpp>
+
+#include "AssetManager.hpp"
+#include "Logger.hpp"
+#include "ThreadPool.hpp"
+
+// Cooks ./assets/ into a pack the game loads instead, for a faster start.
+// Usage: horizons_cook [output file]
+int main(const int argc, char** argv) {
+    if (argc > 2) {
+        std::println("Usage: {} [output file]", argv[0]);
+        return 1;
+    }
+    const std::filesystem::path path = argc == 2 ? argv[1] : AssetManager::k_pack_path;
+
+    // Library configuration
+    SetTraceLogLevel(LOG_WARNING);
+
+    Logger::set_level(LogLevel::Info);
+    Logger::get().add_sink(std::make_unique<ConsoleSink>());
+
+    ThreadPool thread_pool(0);
+    AssetManager asset_manager;
+    try {
+        asset_manager.cook_pack(path, &thread_pool);
+    } catch (const std::exception& e) {
+        std::println("Couldn't cook assets: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+// Copyright 2025 RestingImmortal
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <print>
+
+#include <raylib-cpp.hpp>
+
+#include "ConfigManager.hpp"
+#include "Game.hpp"
+#include "Logger.hpp"
+
+// Runs the simulation without a window, for servers and for benchmarking.
+// Usage: game_headless [tick count]
+int main(const int argc, char** argv) {
+    uint64_t tick_count = 10'000;
+    if (argc > 1) {
+        const char* end = argv[1] + std::strlen(argv[1]);
+        if (const auto [ptr, ec] = std::from_chars(argv[1], end, tick_count); ec != std::errc{} || ptr != end) {
+            std::println("Usage: {} [tick count]", argv[0]);
+            return 1;
+        }
+    }
+
+    // Library configuration
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Horizons configuration
+    const ConfigManager configs;
+
+    Logger::set_level(configs.log_level);
+    Logger::set_rate_limit(configs.log_rate_limit);
+    Logger::get().add_sink(std::make_unique<ConsoleSink>());
+    if (configs.async_logging) {
+        Logger::get().start_async(configs.log_queue_size);
+    }
+    if (!configs.binary_log.empty() && !Logger::get().start_binary(configs.binary_log)) {
+        H_WARNING("main", "Couldn't open binary log {}", configs.binary_log);
+    }
+
+    // Game
+    Game game(configs);
+    game.run_headless(tick_count);
+
+    // Exiting
+    return 0;
+}
@@ -0,0 +1,279 @@
+// Copyright 2025 RestingImmortal
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <print>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "BinaryLog.hpp"
+#include "Logger.hpp"
+
+// Turns a binary log, written when binary_log is set in META.json, back into the same text the console would show.
+// Usage: horizons_logdecode <log file> [output file]
+namespace {
+    using Arg = std::variant<int64_t, uint64_t, float, double, bool, char, std::string_view>;
+
+    struct Site {
+        LogLevel level;
+        std::string_view context;
+        std::string_view format;
+        std::string_view file;
+        uint64_t line;
+    };
+
+    struct Line {
+        uint64_t time_ns;
+        uint32_t site;
+        const std::byte* args;
+        const std::byte* end;
+    };
+
+    template <typename T>
+    bool read(const std::byte*& data, const std::byte* end, T& value) {
+        if (static_cast<std::size_t>(end - data) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return true;
+    }
+
+    // Returns false if the arguments run past the end of their record, which only happens to a damaged file.
+    bool read_args(const std::byte* data, const std::byte* end, std::vector<Arg>& args) {
+        args.clear();
+
+        while (data < end) {
+            BinaryLog::ArgType type;
+            if (!read(data, end, type)) {
+                return false;
+            }
+
+            bool ok = false;
+            switch (type) {
+                case BinaryLog::ArgType::Int:    { int64_t value;  ok = read(data, end, value); args.emplace_back(value); break; }
+                case BinaryLog::ArgType::UInt:   { uint64_t value; ok = read(data, end, value); args.emplace_back(value); break; }
+                case BinaryLog::ArgType::Float:  { float value;    ok = read(data, end, value); args.emplace_back(value); break; }
+                case BinaryLog::ArgType::Double: { double value;   ok = read(data, end, value); args.emplace_back(value); break; }
+                case BinaryLog::ArgType::Bool:   { uint8_t value;  ok = read(data, end, value); args.emplace_back(value != 0); break; }
+                case BinaryLog::ArgType::Char:   { char value;     ok = read(data, end, value); args.emplace_back(value); break; }
+                case BinaryLog::ArgType::String: {
+                    uint32_t length;
+                    ok = read(data, end, length) && static_cast<std::size_t>(end - data) >= length;
+                    if (ok) {
+                        args.emplace_back(std::string_view(reinterpret_cast<const char*>(data), length));
+                        data += length;
+                    }
+                    break;
+                }
+            }
+
+            if (!ok) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::string format_arg(const Arg& arg, const std::string_view spec) {
+        const std::string pattern = std::format("{{{}}}", spec);
+        return std::visit([&pattern](const auto& value) {
+            try {
+                return std::vformat(pattern, std::make_format_args(value));
+            } catch (const std::format_error&) {
+                // A spec that made sense for the original type but not the one it was stored as, say a custom formatter's.
+                return std::format("{}", value);
+            }
+        }, arg);
+    }
+
+    // Does what std::format would have, one replacement field at a time.
+    std::string format_line(const std::string_view format, const std::vector<Arg>& args) {
+        std::string out;
+        std::size_t next_arg = 0;
+
+        for (std::size_t i = 0; i < format.size(); i++) {
+            const char c = format[i];
+
+            if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+                out += c;
+                i++;
+                continue;
+            }
+            if (c != '{') {
+                out += c;
+                continue;
+            }
+
+            const std::size_t close = format.find('}', i);
+            if (close == std::string_view::npos) {
+                out += format.substr(i);
+                break;
+            }
+
+            const std::string_view field = format.substr(i + 1, close - i - 1);
+            const std::size_t colon = field.find(':');
+            const std::string_view id = field.substr(0, colon);
+            const std::string_view spec = colon == std::string_view::npos ? std::string_view() : field.substr(colon);
+
+            std::size_t index = next_arg++;
+            if (!id.empty()) {
+                index = 0;
+                for (const char digit : id) {
+                    index = index * 10 + static_cast<std::size_t>(digit - '0');
+                }
+            }
+
+            out += index < args.size() ? format_arg(args[index], spec) : std::string("{?}");
+            i = close;
+        }
+
+        return out;
+    }
+}
+
+int main(const int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::println("Usage: {} <log file> [output file]", argv[0]);
+        return 1;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input) {
+        std::println("Couldn't open {}", argv[1]);
+        return 1;
+    }
+    const std::vector<char> file((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    const auto* begin = reinterpret_cast<const std::byte*>(file.data());
+    const auto* end = begin + file.size();
+
+    BinaryLog::Header header;
+    const std::byte* cursor = begin;
+    if (!read(cursor, end, header) || header.magic != BinaryLog::k_magic) {
+        std::println("{} isn't a Horizons binary log", argv[1]);
+        return 1;
+    }
+    if (header.version != BinaryLog::k_version) {
+        std::println("{} is version {} of the format, but only version {} is supported", argv[1], header.version, BinaryLog::k_version);
+        return 1;
+    }
+
+    // Sites are gathered first, as one might be described after lines from another thread that were reserved earlier.
+    std::unordered_map<uint32_t, Site> sites;
+    std::vector<Line> lines;
+    std::vector<Arg> args;
+    bool damaged = false;
+
+    while (static_cast<std::size_t>(end - cursor) >= sizeof(BinaryLog::RecordHeader)) {
+        // Records never cross into the next window, so a window can end with less than a header's worth of zeroes.
+        if (header.window_size != 0) {
+            const auto offset = static_cast<std::size_t>(cursor - begin);
+            const std::size_t window_left = header.window_size - offset % header.window_size;
+            if (window_left < sizeof(BinaryLog::RecordHeader)) {
+                cursor += std::min(window_left, static_cast<std::size_t>(end - cursor));
+                continue;
+            }
+        }
+
+        const std::byte* record = cursor;
+        BinaryLog::RecordHeader record_header;
+        read(cursor, end, record_header);
+
+        // The unused end of a window. The next record starts at the next window.
+        if (record_header.length == 0) {
+            if (header.window_size == 0) {
+                break;
+            }
+            const auto offset = static_cast<std::size_t>(record - begin);
+            const std::size_t next_window = (offset / header.window_size + 1) * header.window_size;
+            cursor = begin + std::min(next_window, file.size());
+            continue;
+        }
+
+        if (
+            record_header.length < sizeof(BinaryLog::RecordHeader) ||
+            static_cast<std::size_t>(end - record) < record_header.length
+        ) {
+            damaged = true;
+            break;
+        }
+
+        const std::byte* record_end = record + record_header.length;
+        cursor = record_end;
+
+        if (record_header.site != BinaryLog::k_site_record) {
+            lines.push_back({record_header.time_ns, record_header.site, record + sizeof(BinaryLog::RecordHeader), record_end});
+            continue;
+        }
+
+        if (
+            !read_args(record + sizeof(BinaryLog::RecordHeader), record_end, args) || args.size() != 6 ||
+            !std::holds_alternative<uint64_t>(args[0]) || !std::holds_alternative<uint64_t>(args[1]) ||
+            !std::holds_alternative<std::string_view>(args[2]) || !std::holds_alternative<std::string_view>(args[3]) ||
+            !std::holds_alternative<std::string_view>(args[4]) || !std::holds_alternative<uint64_t>(args[5])
+        ) {
+            damaged = true;
+            continue;
+        }
+
+        sites[static_cast<uint32_t>(std::get<uint64_t>(args[0]))] = {
+            .level = static_cast<LogLevel>(std::get<uint64_t>(args[1])),
+            .context = std::get<std::string_view>(args[2]),
+            .format = std::get<std::string_view>(args[3]),
+            .file = std::get<std::string_view>(args[4]),
+            .line = std::get<uint64_t>(args[5])
+        };
+    }
+
+    // Threads reserve space in about the order they log, but not exactly.
+    std::ranges::stable_sort(lines, {}, &Line::time_ns);
+
+    std::ofstream output_file;
+    if (argc == 3) {
+        output_file.open(argv[2]);
+        if (!output_file) {
+            std::println("Couldn't open {}", argv[2]);
+            return 1;
+        }
+    }
+    std::ostream& output = argc == 3 ? static_cast<std::ostream&>(output_file) : std::cout;
+
+    const auto started = std::chrono::sys_time<std::chrono::nanoseconds>(std::chrono::nanoseconds(header.start_unix_ns));
+    std::println(output, "Log started {:%F %T} UTC", std::chrono::floor<std::chrono::milliseconds>(started));
+
+    for (const auto& line : lines) {
+        const auto seconds = static_cast<double>(line.time_ns) / 1e9;
+
+        const auto site = sites.find(line.site);
+        if (site == sites.end()) {
+            std::println(output, "[+{:.6f}] [?] [?] Line from unknown call site {}", seconds, line.site);
+            damaged = true;
+            continue;
+        }
+        if (!read_args(line.args, line.end, args)) {
+            damaged = true;
+        }
+
+        std::println(
+            output, "[+{:.6f}] [{}] [{}] {}",
+            seconds, Logger::to_string(site->second.level), site->second.context, format_line(site->second.format, args)
+        );
+    }
+
+    if (damaged) {
+        std::println("Parts of {} were damaged and have been skipped, likely from the game not shutting down cleanly", argv[1]);
+    }
+
+    return 0;
+}